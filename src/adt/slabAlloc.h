@@ -0,0 +1,146 @@
+/*========================================================================\
+|: [Filename] slabAlloc.h                                                :|
+:| [Author]   Chiang Chun-Yi                                             |:
+|: [Synopsis] Define and implement the size-class slab allocator for     :|
+:|            small variable-length blocks                               |:
+<------------------------------------------------------------------------*/
+
+#ifndef HEHE_SLABALLOC_H
+#define HEHE_SLABALLOC_H
+
+#include <assert.h>
+#include <new>
+#include <mutex>
+using namespace std;
+
+namespace _54ff
+{
+
+/*
+	Blocks are rounded up to a multiple of 16 bytes, and every size class keeps an intrusive free list,
+	so both allocation and deallocation are O(1) without going through malloc
+	New blocks are carved from 64 KB chunks, and the tail of a used-up chunk goes to the free list of its size
+
+	Every thread owns a pool, but a block may be freed by another thread and then reused there,
+	hence chunks are never returned to the system. The free lists of an exiting thread are kept in a depot
+	and adopted by the next pool, so the memory is still recycled
+	Cubes in a frame are shared with the proof obligations and the traces by reference counting,
+	so a frame is released by dropping its cubes one by one, each in O(1)
+	Blocks larger than the biggest class go to operator new directly
+
+	The live and peak bytes are counted per thread, and the live bytes may be negative
+	if the thread frees blocks allocated by the others
+*/
+class SlabAlloc
+{
+public:
+	static void* allocate(size_t bytes) { return getPool().allocate(bytes); }
+	static void deallocate(void* ptr, size_t bytes) { getPool().deallocate(ptr, bytes); }
+
+	static long long getLiveBytes() { return getPool().liveBytes; }
+	static long long getPeakBytes() { return getPool().peakBytes; }
+	static void resetPeak() { Pool& p = getPool(); p.peakBytes = p.liveBytes; }
+
+private:
+	static constexpr size_t CLASS_BYTES = 16;
+	static constexpr size_t CLASS_NUM   = 64;
+	static constexpr size_t CHUNK_BYTES = size_t(1) << 16;
+
+	static size_t getClass(size_t bytes) { return (bytes - 1) / CLASS_BYTES; }
+	static size_t getClassBytes(size_t c) { return (c + 1) * CLASS_BYTES; }
+
+	struct FreeBlock { FreeBlock* next; };
+
+	struct Depot
+	{
+		mutex       lock;
+		FreeBlock*  freeList[CLASS_NUM] = {};
+	};
+
+	struct Pool
+	{
+		Pool()
+		{
+			Depot& d = getDepot();
+			lock_guard<mutex> guard(d.lock);
+			for(size_t c = 0; c < CLASS_NUM; ++c)
+				freeList[c] = d.freeList[c], d.freeList[c] = 0;
+		}
+		~Pool()
+		{
+			pushRest();
+			Depot& d = getDepot();
+			lock_guard<mutex> guard(d.lock);
+			for(size_t c = 0; c < CLASS_NUM; ++c)
+				if(FreeBlock* b = freeList[c]; b != 0)
+				{
+					while(b->next != 0) b = b->next;
+					b->next = d.freeList[c];
+					d.freeList[c] = freeList[c];
+				}
+		}
+
+		void* allocate(size_t bytes)
+		{
+			assert(bytes != 0);
+			const size_t c = getClass(bytes);
+			if(c >= CLASS_NUM)
+				{ count(bytes); return operator new(bytes); }
+			const size_t s = getClassBytes(c);
+			count(s);
+			if(FreeBlock* b = freeList[c]; b != 0)
+				{ freeList[c] = b->next; return b; }
+			if(size_t(restEnd - restPtr) < s)
+			{
+				pushRest();
+				restPtr = (char*)operator new(CHUNK_BYTES);
+				restEnd = restPtr + CHUNK_BYTES;
+			}
+			void* ret = restPtr;
+			restPtr += s;
+			return ret;
+		}
+
+		void deallocate(void* ptr, size_t bytes)
+		{
+			const size_t c = getClass(bytes);
+			if(c >= CLASS_NUM)
+				{ liveBytes -= bytes; operator delete(ptr); return; }
+			liveBytes -= getClassBytes(c);
+			push(ptr, c);
+		}
+
+		void count(size_t bytes)
+		{
+			liveBytes += bytes;
+			if(liveBytes > peakBytes) peakBytes = liveBytes;
+		}
+		void push(void* ptr, size_t c)
+		{
+			FreeBlock* b = (FreeBlock*)ptr;
+			b->next = freeList[c];
+			freeList[c] = b;
+		}
+		void pushRest()
+		{
+			for(; size_t(restEnd - restPtr) > getClassBytes(CLASS_NUM - 1); restPtr += getClassBytes(CLASS_NUM - 1))
+				push(restPtr, CLASS_NUM - 1);
+			if(restPtr != restEnd)
+				push(restPtr, getClass(restEnd - restPtr));
+			restPtr = restEnd = 0;
+		}
+
+		FreeBlock*  freeList[CLASS_NUM] = {};
+		char*       restPtr   = 0;
+		char*       restEnd   = 0;
+		long long   liveBytes = 0;
+		long long   peakBytes = 0;
+	};
+
+	static Depot& getDepot() { static Depot depot; return depot; }
+	static Pool& getPool() { static thread_local Pool pool; return pool; }
+};
+
+}
+
+#endif
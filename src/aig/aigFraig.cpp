@@ -81,6 +81,8 @@ AigFraiger::simpNtk(AigNtk* ntkToSimp, bool noFraig, bool doTwoLevel)
 		else if(auto [iter, distinct] = strashSet.emplace(a);
 		        !distinct) iter->helpSetEq(a);
 
+		// The merges only move the fanins to the gates before, so the order of the view holds
+		ntk->updateFlatView(a->getGateID());
 		if(noFraig || a->toDelete()) continue;
 		/* fraig */
 		const AigGateID id = a->getGateID();
@@ -129,6 +131,7 @@ AigFraiger::simpNtk(AigNtk* ntkToSimp, bool noFraig, bool doTwoLevel)
 	for(AigAnd* a: dfsList)
 		if(a->toDelete())
 			ntk->removeGate(a->getGateID());
+	ntk->invalidateFlatView();
 	unsigned totalCount = 0;
 	simpMsg << RepeatChar('-', 72) << endl;
 	cout << "Optimize = " << fraigCount[FRAIG_OPTIMIZE]
@@ -165,12 +168,14 @@ AigFraiger::calMaxFail()const
 void
 AigFraiger::simAllAnd()
 {
-	for(AigAnd* a: dfsList)
+	const AigFlatView& view = ntk->getFlatView();
+	for(AigGateID id: view.getAndList())
 	{
-		simValue[a->getGateID()]  = a->isFanIn0Inv() ? ~simValue[a->getFanIn0ID()]:
-		                                                simValue[a->getFanIn0ID()];
-		simValue[a->getGateID()] &= a->isFanIn1Inv() ? ~simValue[a->getFanIn1ID()]:
-		                                                simValue[a->getFanIn1ID()];
+		const AigGateLit in0 = view.getFanIn0(id), in1 = view.getFanIn1(id);
+		simValue[id]  = isInv(in0) ? ~simValue[getGateID(in0)]:
+		                              simValue[getGateID(in0)];
+		simValue[id] &= isInv(in1) ? ~simValue[getGateID(in1)]:
+		                              simValue[getGateID(in1)];
 	}
 }
 
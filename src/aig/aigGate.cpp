@@ -18,9 +18,45 @@ const string aigTypeStr[AIG_TOTAL] =
 	"Const0"
 };
 
-unsigned AigGate::globalRef = 0;
+thread_local unsigned AigGate::globalRef = 0;
 bool AigGate::includeGateType[AIG_TOTAL];
 
+// Shared by the traversals below, so deep networks do not overflow the call stack
+static thread_local vector<pair<const AigGate*, unsigned>> dfsStack;
+
+/*
+	Post-order DFS from root with an explicit stack
+	fanInNum(g) : number of fanins of g to go through
+	enter(g)    : whether to go into the fanin g
+	visit(g)    : called after all the fanins of g are done
+	A gate is marked by the global reference once entered
+*/
+template <class FanInNum, class Enter, class Visit>
+static void iterDfs(const AigGate* root, FanInNum fanInNum, Enter enter, Visit visit)
+{
+	if(root->isGlobalRef())
+		return;
+	root->setToGlobalRef();
+	dfsStack.emplace_back(root, 0);
+	while(!dfsStack.empty())
+	{
+		const AigGate* g = dfsStack.back().first;
+		if(unsigned& i = dfsStack.back().second; i < fanInNum(g))
+		{
+			const AigGate* in = g->getFanInPtr(i++);
+			if(!in->isGlobalRef() && enter(in))
+				in->setToGlobalRef(),
+				dfsStack.emplace_back(in, 0);
+		}
+		else
+			visit(g),
+			dfsStack.pop_back();
+	}
+}
+
+static bool enterAll(const AigGate*) { return true; }
+static void visitNone(const AigGate*) {}
+
 AigGateID
 AigGateV::getGateID()const
 {
@@ -104,63 +140,34 @@ AigGate::setIncludeFlag(bool i, bool l, bool o, bool a, bool c)
 void
 AigGate::traverseFromCO()const
 {
-	if(isGlobalRef())
-		return;
-	setToGlobalRef();
-	if(isCI()) return;
-	assert(getGateType() == AIG_AND);
-	getFanIn0Ptr()->traverseFromCO();
-	getFanIn1Ptr()->traverseFromCO();
+	auto fanInNum = [](const AigGate* g) -> size_t
+		{ assert(g->isCI() || g->getGateType() == AIG_AND); return g->isCI() ? 0 : 2; };
+	iterDfs(this, fanInNum, enterAll, visitNone);
 }
 
 void
 AigGate::traverseFromPO()const
 {
-	if(isGlobalRef())
-		return;
-	setToGlobalRef();
-
-	switch(getFanInNum())
-	{
-		case 1: getFanIn0Ptr()->traverseFromPO(); break;
-		case 2: getFanIn0Ptr()->traverseFromPO();
-		        getFanIn1Ptr()->traverseFromPO(); break;
-		default: assert(getFanInNum() == 0); break;
-	}
+	auto fanInNum = [](const AigGate* g) { return g->getFanInNum(); };
+	iterDfs(this, fanInNum, enterAll, visitNone);
 }
 
 void
 AigGate::genDfsList(vector<AigGate*>& dfsList)const
 {
-	if(isGlobalRef())
-		return;
-	setToGlobalRef();
-
-	switch(getFanInNum())
-	{
-		case 1: getFanIn0Ptr()->genDfsList(dfsList); break;
-		case 2: getFanIn0Ptr()->genDfsList(dfsList);
-		        getFanIn1Ptr()->genDfsList(dfsList); break;
-		default: assert(getFanInNum() == 0); break;
-	}
-
-	if(includeGateType[getGateType()])
-		dfsList.push_back(const_cast<AigGate*>(this));
+	auto fanInNum = [](const AigGate* g) { return g->getFanInNum(); };
+	auto visit = [&dfsList](const AigGate* g)
+		{ if(includeGateType[g->getGateType()]) dfsList.push_back(const_cast<AigGate*>(g)); };
+	iterDfs(this, fanInNum, enterAll, visit);
 }
 
 void
-AigGate::genDfsList(vector<AigAnd*>& dfsList)const
+AigGate::genDfsList(vector<AigGateID>& dfsList)const
 {
-	if(isGlobalRef())
-		return;
-	setToGlobalRef();
-
-	if(getGateType() == AIG_AND)
-	{
-		getFanIn0Ptr()->genDfsList(dfsList);
-		getFanIn1Ptr()->genDfsList(dfsList);
-		dfsList.push_back(reinterpret_cast<AigAnd*>(const_cast<AigGate*>(this)));
-	}
+	auto fanInNum = [](const AigGate* g) -> size_t { return g->getGateType() == AIG_AND ? 2 : 0; };
+	auto visit = [&dfsList](const AigGate* g)
+		{ if(g->getGateType() == AIG_AND) dfsList.push_back(g->getGateID()); };
+	iterDfs(this, fanInNum, enterAll, visit);
 }
 
 void 
@@ -184,55 +191,49 @@ AigGate::printFanInConeRec(unsigned curLevel, unsigned maxLevel, bool bound, boo
 bool
 AigAnd::checkCombLoop(bool repErr, vector<AigAnd*>* dfsList)const
 {
+	// Ref 1 marks the gates on the current path, ref 0 the finished ones
 	assert(!isGlobalRef() && !isGlobalRef(1));
 	setToGlobalRef(1);
-	union { AigGate* fanInG; AigAnd* fanInA; };
 	bool result = true;
-	fanInG = getFanIn0Ptr();
-	if(fanInG->getGateType() == AIG_AND)
+	dfsStack.emplace_back(this, 0);
+	while(!dfsStack.empty())
 	{
-		if(fanInA->isGlobalRef(1))
+		const AigGate* g = dfsStack.back().first;
+		if(unsigned& i = dfsStack.back().second; i < 2)
 		{
-			result = false;
-			if(repErr)
-				cerr << "[Error] A combinational loop is deteced between gate with ID "
-				     << getGateID() << " and " << fanInA->getGateID() << "!" << endl;
+			const AigGate* in = g->getFanInPtr(i++);
+			if(in->getGateType() != AIG_AND)
+				continue;
+			if(in->isGlobalRef(1))
+			{
+				result = false;
+				if(repErr)
+					cerr << "[Error] A combinational loop is deteced between gate with ID "
+					     << g->getGateID() << " and " << in->getGateID() << "!" << endl;
+			}
+			else if(!in->isGlobalRef(0))
+				//it must dfs into deeper, not blocked by previous false
+				in->setToGlobalRef(1),
+				dfsStack.emplace_back(in, 0);
 		}
-		else if(!fanInA->isGlobalRef(0))
-			//it must dfs into deeper, not blocked by previous false
-			result = fanInA->checkCombLoop(repErr, dfsList) && result;
-	}
-	fanInG = getFanIn1Ptr();
-	if(fanInG->getGateType() == AIG_AND)
-	{
-		if(fanInA->isGlobalRef(1))
+		else
 		{
-			result = false;
-			if(repErr)
-				cerr << "[Error] A combinational loop is deteced between gate with ID "
-				     << getGateID() << " and " << fanInA->getGateID() << "!" << endl;
+			if(dfsList != 0)
+				(*dfsList).push_back(static_cast<AigAnd*>(const_cast<AigGate*>(g)));
+			g->setToGlobalRef(0);
+			dfsStack.pop_back();
 		}
-		else if(!fanInA->isGlobalRef(0))
-			result = fanInA->checkCombLoop(repErr, dfsList) && result;
 	}
-	if(dfsList != 0)
-		(*dfsList).push_back(const_cast<AigAnd*>(this));
-	setToGlobalRef(0);
 	return result;
 }
 
 void
 AigAnd::genCombDfsList(vector<AigAnd*>& dfsList)const
 {
-	if(isGlobalRef())
-		return;
-	setToGlobalRef();
-	union { AigGate* fanInG; AigAnd* fanInA; };
-	if(fanInG = getFanIn0Ptr(); fanInG->getGateType() == AIG_AND)
-		fanInA->genCombDfsList(dfsList);
-	if(fanInG = getFanIn1Ptr(); fanInG->getGateType() == AIG_AND)
-		fanInA->genCombDfsList(dfsList);
-	dfsList.push_back(const_cast<AigAnd*>(this));
+	auto fanInNum = [](const AigGate*) -> size_t { return 2; };
+	auto enter = [](const AigGate* g) { return g->getGateType() == AIG_AND; };
+	auto visit = [&dfsList](const AigGate* g) { dfsList.push_back(static_cast<AigAnd*>(const_cast<AigGate*>(g))); };
+	iterDfs(this, fanInNum, enter, visit);
 }
 
 void
@@ -120,11 +120,12 @@ public:
 	void traverseFromCO()const;
 	void traverseFromPO()const;
 	void genDfsList(vector<AigGate*>&)const;
-	void genDfsList(vector<AigAnd*>&)const;
+	void genDfsList(vector<AigGateID>&)const;
 
 	/*====================================*/
 
 	static void setGlobalRef(unsigned diff = 1) { globalRef += diff; }
+	static unsigned getGlobalRef() { return globalRef; }
 	bool isGlobalRef(unsigned diff = 0)const { return ref == globalRef - diff; }
 	bool inGlobalRef(unsigned diff)const { return ref >= globalRef - diff; }
 	void setToGlobalRef(unsigned diff = 0)const { ref = globalRef - diff; }
@@ -143,8 +144,10 @@ protected:
 private:
 	void printFanInConeRec(unsigned, unsigned, bool, bool = false)const;
 
-	static unsigned  globalRef;
-	static bool      includeGateType[AIG_TOTAL];
+	// Thread local so that checkers running in parallel on their own copies
+	// of the network do not disturb the traversal of each other
+	static thread_local unsigned  globalRef;
+	static bool                   includeGateType[AIG_TOTAL];
 };
 
 class AigGateWithFanIn1 : public AigGate
@@ -282,12 +282,18 @@ AigSimulator::setValueEventRef(AigGateID id, ThreeValue v)
 }
 
 ThreeValue
-AigSimulator::simOneAndValue(AigAnd* a)const
+AigSimulator::simOneAndValue(AigGateID id)const
 {
-	return simAnd(a->isFanIn0Inv() ? simNot(simValue[a->getFanIn0ID()]):
-	                                        simValue[a->getFanIn0ID()],
-	              a->isFanIn1Inv() ? simNot(simValue[a->getFanIn1ID()]):
-	                                        simValue[a->getFanIn1ID()]);
+	const AigFlatView& view = ntk->getFlatView();
+	return simAnd(getLitValue(view.getFanIn0(id)), getLitValue(view.getFanIn1(id)));
+}
+
+void
+AigSimulator::simDfsList()
+{
+	const AigFlatView& view = ntk->getFlatView();
+	for(AigGateID id: dfsList)
+		simValue[id] = simAnd(getLitValue(view.getFanIn0(id)), getLitValue(view.getFanIn1(id)));
 }
 
 ThreeValue
@@ -342,9 +348,10 @@ AigSimulator::simByEvent()
 void
 AigSimulator::simAllLatchSynch()
 {
+	const AigFlatView& view = ntk->getFlatView();
 	const size_t L = ntk->getLatchNum();
 	for(size_t i = 0; i < L; ++i)
-		nextState[i] = simOneCOValue(ntk->getLatchNorm(i));
+		nextState[i] = getLitValue(view.getLatchNext(i));
 	for(size_t i = 0; i < L; ++i)
 		simValue[ntk->getLatchID(i)] = nextState[i];
 }
@@ -377,6 +384,15 @@ AigSimulator::printAllOutput(ostream& os)const
 		os << getSymbol(getOutputValue(i));
 }
 
+bool
+AigSimulator::checkCombLoop()
+{
+	if(!ntk->checkCombLoop(true))
+		return false;
+	dfsList = ntk->getFlatView().getAndList();
+	return true;
+}
+
 void
 AigSimulator::genDfsList(const vector<AigGateID>& target)
 {
@@ -390,12 +406,12 @@ AigSimulator::doConstProp(const vector<AigGateID>& target)
 {
 	size_t s = 0;
 	for(size_t i = 0, n = dfsList.size(); i < n; ++i)
-		if(getValue(dfsList[i]->getGateID()) == ThreeValue_DC)
+		if(getValue(dfsList[i]) == ThreeValue_DC)
 			dfsList[s++] = dfsList[i];
 	dfsList.resize(s);
 	AigGate::setGlobalRef();
-	for(AigAnd* a: dfsList)
-		a->setToGlobalRef();
+	for(AigGateID id: dfsList)
+		ntk->getGate(id)->setToGlobalRef();
 	AigGate::setGlobalRef();
 	for(AigGateID id: target)
 		if(AigGate* g = ntk->getGate(id);
@@ -403,23 +419,94 @@ AigSimulator::doConstProp(const vector<AigGateID>& target)
 			g->setToGlobalRef();
 	for(size_t i = s - 1; i != MAX_SIZE_T; --i)
 	{
-		if(dfsList[i]->isGlobalRef())
+		AigGateID id = dfsList[i];
+		if(ntk->getGate(id)->isGlobalRef())
 			continue;
-		AigGateID id = dfsList[i]->getGateID();
 		for(size_t j = 0, n = fanOut.getFanOutNum(id); j < n; ++j)
 			if(fanOut.getFanOut(id, j)->isGlobalRef())
 				goto KEEP;
-		dfsList[i] = 0;
+		dfsList[i] = UNDEF_GATEID;
 		continue;
-		KEEP: dfsList[i]->setToGlobalRef();
+		KEEP: ntk->getGate(id)->setToGlobalRef();
 	}
 	size_t ss = 0;
 	for(size_t i = 0; i < s; ++i)
-		if(dfsList[i] != 0)
+		if(dfsList[i] != UNDEF_GATEID)
 			dfsList[ss++] = dfsList[i];
 	dfsList.resize(ss);
 }
 
+/*
+	Same result as dropping the literals one by one in order,
+	i.e. a literal is kept iff the targets become X
+	with it and all the literals dropped before it being X.
+	Lane j of a pass sets the next j+1 undecided literals to X,
+	so the first lane making X on the targets is the first necessary literal,
+	and all the literals before it are dropped.
+	The values of the other gates are taken from simValue.
+*/
+void
+AigSimulator::dropByParaSim(vector<AigGateLit>& cube, const vector<AigGateID>& target)
+{
+	if(paraValue.empty())
+		paraValue.init(ntk->getMaxGateNum());
+	markDfsList();
+	paraLeaf.clear();
+	auto addLeaf = [this](AigGateID id)
+		{ if(AigGate* g = ntk->getGate(id); !g->isGlobalRef()) { g->setToGlobalRef(); paraLeaf.push_back(id); } };
+	const AigFlatView& view = ntk->getFlatView();
+	for(AigGateID id: dfsList)
+		addLeaf(getGateID(view.getFanIn0(id))),
+		addLeaf(getGateID(view.getFanIn1(id)));
+	for(AigGateID id: target)
+		addLeaf(id);
+
+	size_t s = 0;
+	for(size_t i = 0, n = cube.size(); i < n;)
+	{
+		const unsigned w = min(n - i, size_t(paraWidth));
+		for(AigGateID id: paraLeaf)
+			setParaValue(id);
+		for(unsigned j = 0; j < w; ++j)
+		{
+			ParaValue& v = paraValue[getGateID(cube[i+j])];
+			const uint64_t laneFromJ = ~uint64_t(0) << j;
+			v.can0 |= laneFromJ;
+			v.can1 |= laneFromJ;
+		}
+		for(AigGateID id: dfsList)
+		{
+			const ParaValue v0 = getParaValue(view.getFanIn0(id));
+			const ParaValue v1 = getParaValue(view.getFanIn1(id));
+			paraValue[id] = { v0.can0 | v1.can0, v0.can1 & v1.can1 };
+		}
+		uint64_t dcLane = 0;
+		for(AigGateID id: target)
+			dcLane |= paraValue[id].can0 & paraValue[id].can1;
+		if(w < paraWidth)
+			dcLane &= ~(~uint64_t(0) << w);
+
+		const unsigned firstDC = dcLane == 0 ? w : __builtin_ctzll(dcLane);
+		for(unsigned j = 0; j < firstDC; ++j)
+			setValue(getGateID(cube[i+j]), ThreeValue_DC);
+		if(firstDC < w)
+			cube[s++] = cube[i+firstDC];
+		i += firstDC == w ? w : firstDC + 1;
+	}
+	cube.resize(s);
+}
+
+void
+AigSimulator::setParaValue(AigGateID id)
+{
+	switch(getValue(id))
+	{
+		case ThreeValue_False : paraValue[id] = { ~uint64_t(0), 0            }; break;
+		case ThreeValue_True  : paraValue[id] = { 0,            ~uint64_t(0) }; break;
+		default               : paraValue[id] = { ~uint64_t(0), ~uint64_t(0) }; break;
+	}
+}
+
 unsigned
 AigSimulator::getMaxLevel(const vector<AigGateID>& target)const
 {
@@ -456,8 +543,8 @@ void
 AigSimulator::markDfsList()const
 {
 	AigGate::setGlobalRef();
-	for(AigAnd* a: dfsList)
-		a->setToGlobalRef();
+	for(AigGateID id: dfsList)
+		ntk->getGate(id)->setToGlobalRef();
 }
 
 void
@@ -467,7 +554,7 @@ AigSimulator::simByEventRef(unsigned maxLevel)
 	for(unsigned l = 0; l <= maxLevel; ++l)
 	{
 		for(AigGateID eventId: eventList[l])
-			setValueEventRef(eventId, simOneAndValue((AigAnd*)(ntk->getGate(eventId)))),
+			setValueEventRef(eventId, simOneAndValue(eventId)),
 			hasEvent[eventId] = false;
 		eventList[l].clear();
 	}
@@ -497,27 +584,28 @@ AigSimulator::backwardTerSim(CirSolver* solver, const vector<AigGateID>& target,
 	for(AigGateID id: target)
 		newEventCheck(id);
 
+	const AigFlatView& view = ntk->getFlatView();
 	for(unsigned l = getMaxLevel(target); l > 0; --l)
 	{
 		for(AigGateID careId: eventList[l])
 		{
+			const AigGateLit fanIn0 = view.getFanIn0(careId);
+			const AigGateLit fanIn1 = view.getFanIn1(careId);
 			if(solver->getValueBool(careId, 0))
 			{
 				//Output = 1, Two fanins should be cared
-				AigGate* g = ntk->getGate(careId);
-				assert(solver->getValueBool(g->getFanIn0ID(), 0) ^ g->isFanIn0Inv());
-				assert(solver->getValueBool(g->getFanIn1ID(), 0) ^ g->isFanIn1Inv());
-				newEventCheck(g->getFanIn0ID());
-				newEventCheck(g->getFanIn1ID());
+				assert(solver->getValueBool(getGateID(fanIn0), 0) ^ isInv(fanIn0));
+				assert(solver->getValueBool(getGateID(fanIn1), 0) ^ isInv(fanIn1));
+				newEventCheck(getGateID(fanIn0));
+				newEventCheck(getGateID(fanIn1));
 			}
 			else
 			{
 				//Output = 0
-				AigGate* g = ntk->getGate(careId);
-				AigGateID fanIn0Id = g->getFanIn0ID();
-				bool isFanIn0False = solver->getValueBool(fanIn0Id, 0) == g->isFanIn0Inv();
-				AigGateID fanIn1Id = g->getFanIn1ID();
-				bool isFanIn1False = solver->getValueBool(fanIn1Id, 0) == g->isFanIn1Inv();
+				AigGateID fanIn0Id = getGateID(fanIn0);
+				bool isFanIn0False = solver->getValueBool(fanIn0Id, 0) == isInv(fanIn0);
+				AigGateID fanIn1Id = getGateID(fanIn1);
+				bool isFanIn1False = solver->getValueBool(fanIn1Id, 0) == isInv(fanIn1);
 				assert(isFanIn0False || isFanIn1False);
 				if(isFanIn0False && isFanIn1False)
 				{
@@ -547,7 +635,7 @@ AigSimulator::backwardTerSim(CirSolver* solver, const vector<AigGateID>& target,
 
 	for(AigGateID cubeId: eventList[0])
 	{
-		switch(ntk->getGate(cubeId)->getGateType())
+		switch(view.getGateType(cubeId))
 		{
 			default: assert(false);
 			case AIG_PI:
@@ -138,9 +138,9 @@ public:
 	void setLatchValueEvent(size_t i, ThreeValue v) { setValueEvent(ntk->getLatchID(i), v); }
 	void setConst0Event() { setValueEvent(0, ThreeValue_False); }
 
-	void simOneAnd(AigAnd* a) { simValue[a->getGateID()] = simOneAndValue(a); }
-	ThreeValue simOneAndValue(AigAnd*)const;
-	void simDfsList() { for(AigAnd* a: dfsList) simOneAnd(a); }
+	void simOneAnd(AigGateID id) { simValue[id] = simOneAndValue(id); }
+	ThreeValue simOneAndValue(AigGateID)const;
+	void simDfsList();
 	void simOneCO(AigGate* g) { simValue[g->getGateID()] = simOneCOValue(g); }
 	ThreeValue simOneCOValue(AigGate*)const;
 	void simOutput(size_t i) { simOneCO(ntk->getOutputNorm(i)); }
@@ -153,6 +153,7 @@ public:
 	void simAllLatch ();
 
 	ThreeValue getValue(AigGateID id)const { return simValue[id]; }
+	ThreeValue getLitValue(AigGateLit lit)const { return isInv(lit) ? simNot(getValue(getGateID(lit))) : getValue(getGateID(lit)); }
 	ThreeValue getInputValue (size_t i)const { return getValue(ntk->getInputID(i)); }
 	ThreeValue getLatchValue (size_t i)const { return getValue(ntk->getLatchID(i)); }
 	ThreeValue getOutputValue(size_t i)const { return getValue(ntk->getOutputID(i)); }
@@ -165,7 +166,7 @@ public:
 	/*====================================*/
 
 	/* For ternary simulation */
-	bool checkCombLoop() { return ntk->checkCombLoop(true, dfsList); }
+	bool checkCombLoop();
 	void reserveDfsList(size_t c) { dfsList.reserve(c); }
 	void reserveAndNum() { reserveDfsList(ntk->getAndNum()); }
 	void clearDfsList() { dfsList.clear(); }
@@ -182,6 +183,8 @@ public:
 	void simByEventRef(unsigned);
 	void cleanEvent(unsigned);
 
+	void dropByParaSim(vector<AigGateLit>&, const vector<AigGateID>&);
+
 	void initInflu() { assert(!influ.isON()); influ.init(ntk); }
 	void influOrder() { assert(influ.isON()); influ.convertToOrder(); }
 	void backwardTerSim(CirSolver*, const vector<AigGateID>&, vector<AigGateID>&, const Array<double>&, bool);
@@ -192,16 +195,30 @@ public:
 	static ThreeValue simAnd(ThreeValue, ThreeValue);
 	static char getSymbol(ThreeValue);
 
+private:
+	// Two bit-planes of 64 ternary values, X has both bits
+	struct ParaValue
+	{
+		uint64_t  can0;
+		uint64_t  can1;
+	};
+	static constexpr unsigned paraWidth = 64;
+	void setParaValue(AigGateID);
+	ParaValue getParaValue(AigGateLit lit)const
+		{ const ParaValue& v = paraValue[getGateID(lit)]; return isInv(lit) ? ParaValue{v.can1, v.can0} : v; }
+
 private:
 	const AigNtk*             ntk;
 	Array<ThreeValue>         simValue;
 	Array<ThreeValue>         nextState;
-	vector<AigAnd*>           dfsList;
+	vector<AigGateID>         dfsList;
 	AigFanouter               fanOut;
 	AigLeveler                level;
 	Array<vector<AigGateID>>  eventList;
 	Array<bool>               hasEvent;
 	AigInfluencer             influ;
+	Array<ParaValue>          paraValue;
+	vector<AigGateID>         paraLeaf;
 };
 
 }
@@ -22,18 +22,18 @@ AigConster::doSimpMono()
 	vector<AigGateID> zeroCand(ntk->getLatchNum());
 	for(size_t i = 0, L = zeroCand.size(); i < L; ++i)
 		zeroCand[i] = ntk->getLatchID(i);
+	const CirCnfTemplate cnfTemplate(ntk);
 	for(size_t iter = 1; true; ++iter)
 	{
 		SolverPtr<CirSolver> solver(ntk);
 		simpMsg << iter << ": " << zeroCand.size() << " -> " << flush;
+		solver->loadCNF(cnfTemplate, 0);
 		for(AigGateID id: zeroCand)
-			solver->convertToCNF(id, 0),
 			solver->addClause(Lit(solver->getVarInt(id, 0), true));
 		size_t n = zeroCand.size();
 		size_t s = 0;
 		for(size_t i = 0; i < n; ++i)
 		{
-			solver->convertToCNF(zeroCand[i], 1);
 			solver->clearAssump();
 			solver->addAssump(zeroCand[i], 1, false);
 			if(!solver->solve())
@@ -132,6 +132,7 @@ AigConster::replaceWithZero(const vector<AigGateID>& zeros)
 
 				default: break;
 			}
+	ntk->invalidateFlatView();
 }
 
 /**************************************/
@@ -282,6 +283,7 @@ AigCutter::prepare()
 				        fanOutNum[g->getFanIn1ID()] += 1; break;
 				default: break;
 			}
+	ntk->invalidateFlatView();
 }
 
 void
@@ -358,11 +360,6 @@ AigCutter::genCutForAndGate(AigAnd* a)
 END:
 	if(idx < maxCutNum)
 		cut[idx] = MAX_UNSIGNED;
-
-cout << a->getGateID() << ": " << idx << " " << cut[0] << " " << PrintHex(getCut(cut[0]).truthTable);
-if(getCut(cut[0]).numLeaves != 0)
-{ assert(getCut(cut[0]).numLeaves == 1); cout << ", " << getCut(cut[0]).leaves[0]; }
-cout << endl;
 }
 
 bool
@@ -71,6 +71,12 @@ public:
 	AigCutter(AigNtk*, unsigned, unsigned);
 	~AigCutter() { operator delete(allCuts); }
 
+	// Only for the CIs and the AND gates in the DFS order of the network
+	// The first cut of an AND gate is the gate itself, unless it is merged with at most one leaf
+	unsigned getCutNum(AigGateID id)const
+		{ unsigned n = 0; for(const unsigned* c = getIdxBasePtr(id); n < maxCutNum && c[n] != MAX_UNSIGNED; ++n); return n; }
+	const AigCut& getCut(AigGateID id, unsigned i)const { return getCut(getIdxBasePtr(id)[i]); }
+
 private:
 	void prepare();
 	void buildCut();
@@ -89,6 +95,7 @@ private:
 	unsigned  getIdxBaseNum(AigGateID id)const { return id * maxCutNum; }
 	unsigned* getIdxBasePtr(AigGateID id)const { return cutIdx + getIdxBaseNum(id); }
 	AigCut& getCut(unsigned idx) { return *(AigCut*)((char*)allCuts + idx * AigCut::calSize(maxLeaves)); }
+	const AigCut& getCut(unsigned idx)const { return *(const AigCut*)((const char*)allCuts + idx * AigCut::calSize(maxLeaves)); }
 
 private:
 	AigNtk*          ntk;
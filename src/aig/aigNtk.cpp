@@ -31,9 +31,72 @@ AigGate* checkGate(AigGateID id, bool report)
 	return g;
 }
 
+AigFlatView::AigFlatView(const AigNtk* ntk)
+: gateType(ntk->getMaxGateNum(), AIG_TOTAL)
+, fanIn0  (ntk->getMaxGateNum(), 0)
+, fanIn1  (ntk->getMaxGateNum(), 0)
+{
+	for(AigGateID i = 0, M = ntk->getMaxGateNum(); i < M; ++i)
+		if(const AigGate* g = ntk->getGate(i); g != 0)
+		{
+			gateType[i] = g->getGateType();
+			if(g->getFanInNum() > 0) fanIn0[i] = makeToLit(g->getFanIn0ID(), g->isFanIn0Inv());
+			if(g->getFanInNum() > 1) fanIn1[i] = makeToLit(g->getFanIn1ID(), g->isFanIn1Inv());
+		}
+	latchNext.resize(ntk->getLatchNum());
+	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
+		latchNext[i] = fanIn0[ntk->getLatchID(i)];
+	andList.reserve(ntk->getAndNum());
+	genAndList();
+}
+
+void
+AigFlatView::updateAnd(const AigNtk* ntk, AigGateID id)
+{
+	const AigGate* g = ntk->getGate(id);
+	assert(g->getGateType() == AIG_AND);
+	fanIn0[id] = makeToLit(g->getFanIn0ID(), g->isFanIn0Inv());
+	fanIn1[id] = makeToLit(g->getFanIn1ID(), g->isFanIn1Inv());
+}
+
+/*
+	The same order as AigNtk::checkCombLoop, without the gate marks
+	An edge closing a combinational loop is skipped
+*/
+void
+AigFlatView::genAndList()
+{
+	// 0 for the new gates, 1 for the ones on the current path, 2 for the finished ones
+	vector<uint8_t> state(gateType.size(), 0);
+	vector<pair<AigGateID, unsigned>> dfsStack;
+	for(AigGateID i = 1, M = gateType.size(); i < M; ++i)
+	{
+		if(gateType[i] != AIG_AND || state[i] != 0)
+			continue;
+		state[i] = 1;
+		dfsStack.emplace_back(i, 0);
+		while(!dfsStack.empty())
+		{
+			const AigGateID id = dfsStack.back().first;
+			if(unsigned& j = dfsStack.back().second; j < 2)
+			{
+				const AigGateID in = getGateID(j++ == 0 ? fanIn0[id] : fanIn1[id]);
+				if(gateType[in] == AIG_AND && state[in] == 0)
+					state[in] = 1,
+					dfsStack.emplace_back(in, 0);
+			}
+			else
+				andList.push_back(id),
+				state[id] = 2,
+				dfsStack.pop_back();
+		}
+	}
+}
+
 AigNtk::~AigNtk()
 {
 	for(AigGate* g: gateList) delete g;
+	delete flatView;
 }
 
 AigNtk*
@@ -71,6 +134,7 @@ AigNtk::moveNtk()
 	POList     .swap(newNtk->POList);
 	gateList   .swap(newNtk->gateList);
 	recycleList.swap(newNtk->recycleList);
+	invalidateFlatView();
 	return newNtk;
 }
 
@@ -83,6 +147,8 @@ AigNtk::swap(AigNtk* ntk)
 	POList     .swap(ntk->POList);
 	gateList   .swap(ntk->gateList);
 	recycleList.swap(ntk->recycleList);
+	invalidateFlatView();
+	ntk->invalidateFlatView();
 }
 
 void
@@ -341,6 +407,7 @@ AigNtk::compress()
 	}
 	cout << "Remove " << recycleList.size() << " recycled!" << endl;
 	vector<AigGateID>().swap(recycleList);
+	invalidateFlatView();
 	return true;
 }
 
@@ -37,6 +37,38 @@ enum AigSimPrintType
 
 extern CondStream simpMsg;
 
+/*
+	Read-only struct-of-arrays copy of the network for the hot passes
+	fanIn0, fanIn1 : fanin literals indexed by gate ID, 0 if none
+	                 (the input of a latch or a PO is its fanIn0)
+	andList        : all the AND gates in topological order
+	latchNext      : next-state literals indexed by latch index
+	It takes about 13 bytes per AND gate, against about 56 for an AigAnd and its pointer
+*/
+class AigFlatView
+{
+public:
+	AigFlatView(const AigNtk*);
+
+	AigGateType getGateType(AigGateID id)const { return AigGateType(gateType[id]); }
+	AigGateLit getFanIn0(AigGateID id)const { return fanIn0[id]; }
+	AigGateLit getFanIn1(AigGateID id)const { return fanIn1[id]; }
+	AigGateLit getLatchNext(size_t i)const { return latchNext[i]; }
+	const vector<AigGateID>& getAndList()const { return andList; }
+
+	void updateAnd(const AigNtk*, AigGateID);
+
+private:
+	void genAndList();
+
+private:
+	vector<uint8_t>     gateType;
+	vector<AigGateLit>  fanIn0;
+	vector<AigGateLit>  fanIn1;
+	vector<AigGateID>   andList;
+	vector<AigGateLit>  latchNext;
+};
+
 class AigNtk
 {
 friend class AigParser;
@@ -45,7 +77,7 @@ friend class AigBinaryParser;
 
 public:
 	AigNtk(const char* n = "hehe")
-	: ntkName(n), gateList(1, new AigConst0()) {}
+	: ntkName(n), gateList(1, new AigConst0()), flatView(0) {}
 	~AigNtk();
 
 	AigNtk(const AigNtk&) = delete;
@@ -149,6 +181,16 @@ public:
 	bool checkValidity(bool)const;
 	bool noLatchInCone(size_t)const;
 
+	/*====================================*/
+
+	// Built on the first call and dropped by the changes through AigNtk,
+	// so call invalidateFlatView after changing the fanins of a gate directly,
+	// and do not keep the view across a change of the network
+	const AigFlatView& getFlatView()const { if(flatView == 0) flatView = new AigFlatView(this); return *flatView; }
+	void invalidateFlatView()const { delete flatView; flatView = 0; }
+	// For the fanins of an AND gate changed without breaking the order of the view
+	void updateFlatView(AigGateID id)const { if(flatView != 0) flatView->updateAnd(this, id); }
+
 public:
 	string  ntkName;
 
@@ -158,10 +200,11 @@ private:
 	vector<AigGateID>  POList;
 	vector<AigGate*>   gateList;
 	vector<AigGateID>  recycleList;
+	mutable AigFlatView* flatView;
 
 	/*====================================*/
 
-	void setGate(AigGateID id, AigGate* gate) { gateList[id] = gate; }
+	void setGate(AigGateID id, AigGate* gate) { gateList[id] = gate; invalidateFlatView(); }
 	AigGateID getValidID();
 	void createInputInt (AigGateID id) { setGate(id, new AigPi   (id)); PIList   .push_back(id); }
 	void createLatchInt (AigGateID id) { setGate(id, new AigLatch(id)); latchList.push_back(id); }
@@ -4,6 +4,10 @@
 |: [Synopsis] Implement the AIGER parser for aig network                 :|
 <------------------------------------------------------------------------*/
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "aigParser.h"
 
 namespace _54ff
@@ -160,10 +164,34 @@ bool
 AigParser::initParsing(const char* fileName)
 {
 	targetNtk = 0;
-	inFile.open(fileName);
-	if(!inFile.is_open())
+	const int fd = open(fileName, O_RDONLY);
+	if(fd < 0)
 		{ errStr = fileName; return parseError(CANNOT_OPEN_FILE); }
 	lineNo = 0;
+	reachEOF = false;
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size != 0)
+		if(void* addr = mmap(0, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0); addr != MAP_FAILED)
+		{
+			mapBegin = (char*)addr;
+			mapSize = fileStat.st_size;
+			madvise(mapBegin, mapSize, MADV_SEQUENTIAL);
+		}
+	if(mapBegin == 0)
+	{
+		//pipes and other unmappable files are read into the buffer at once
+		char readBuf[1 << 16];
+		for(ssize_t n; (n = read(fd, readBuf, sizeof(readBuf))) != 0; )
+			if(n < 0)
+				{ close(fd); incLineNo(); return parseError(UNKNOWN_ACCIDENT); }
+			else
+				fileData.append(readBuf, n);
+		curPtr = fileData.data();
+		endPtr = curPtr + fileData.size();
+	}
+	else
+		{ curPtr = mapBegin; endPtr = mapBegin + mapSize; }
+	close(fd);
 	targetNtk = new AigNtk(fileName);
 	return true;
 }
@@ -453,14 +481,28 @@ AigParser::checkDef(bool leadSpace, const string& definition)
 	return true;
 }
 
+void
+AigParser::closeFile()
+{
+	if(mapBegin != 0)
+		munmap(mapBegin, mapSize);
+	mapBegin = 0;
+	mapSize = 0;
+	fileData.clear();
+	fileData.shrink_to_fit();
+}
+
 bool
 AigParser::readOneLine()
 {
+	// Same as getline, EOF is reached only if the line is not ended by a newline
 	incLineNo();
 	resetColNo();
-	getline(inFile, buffer, '\n');
-	if(inFile.fail() && !inFile.eof())
-		return parseError(UNKNOWN_ACCIDENT);
+	const char* lineEnd = curPtr == endPtr ? 0 : (const char*)memchr(curPtr, '\n', endPtr - curPtr);
+	if(lineEnd == 0)
+		{ buffer = string_view(curPtr, endPtr - curPtr); curPtr = endPtr; reachEOF = true; }
+	else
+		{ buffer = string_view(curPtr, lineEnd - curPtr); curPtr = lineEnd + 1; }
 	return true;
 }
 
@@ -743,26 +785,37 @@ AigBinaryParser::decode(unsigned& num)
 {
 	constexpr unsigned  int maxI = (sizeof(unsigned) * 8) / 7;
 	constexpr unsigned char maxC = 1 << ((sizeof(unsigned) * 8) % 7);
-	constexpr char GET_VALUE_MASK = 0x7F;
-	constexpr char CHECK_END_MASK = 0x80;
+	constexpr unsigned char GET_VALUE_MASK = 0x7F;
+	constexpr unsigned char CHECK_END_MASK = 0x80;
 	num = 0;
 	unsigned i = 0;
-	char c;
+	unsigned char c;
 	setOldColNo();
+	const unsigned char* p = (const unsigned char*)curPtr;
+	const unsigned char* const e = (const unsigned char*)endPtr;
+	//if the longest encoding fits before the end of the file, the bound check can be skipped
+	const bool inBound = size_t(e - p) > maxI;
 	do
 	{
-		if(isEOF())
-			{ errStr = "the binary encoding of AND gate"; return parseError(UNEXPECTED_EOF); }
-		if(inFile.get(c).fail())
+		if(!inBound && p == e)
+		{
+			colNo += p - (const unsigned char*)curPtr; curPtr = endPtr;
+			//the same as reading through a stream, the first read beyond the end fails
+			if(isEOF())
+				{ errStr = "the binary encoding of AND gate"; return parseError(UNEXPECTED_EOF); }
+			reachEOF = true;
 			return parseError(UNKNOWN_ACCIDENT);
-		incColNo();
-		//for "(unsigned char)c >= maxC"
+		}
+		c = *p++;
+		//for "c >= maxC"
 		//1. if c & 0x80 = 0x80, violate trivially
 		//2. if c & 0x80 = 0, compare c & 0x7F and maxC
-		if(i == maxI && (unsigned char)c >= maxC)
+		if(i == maxI && c >= maxC)
 			{ setColNo(); return parseError(NUMBER_OVERFLOW); }
 		num |= unsigned(c & GET_VALUE_MASK) << (7 * i++);
 	} while(c & CHECK_END_MASK);
+	colNo += p - (const unsigned char*)curPtr;
+	curPtr = (const char*)p;
 	return true;
 }
 
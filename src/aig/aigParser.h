@@ -10,6 +10,7 @@
 #include <ctype.h>
 #include <limits.h>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include "aigNtk.h"
 using namespace std;
@@ -52,17 +53,23 @@ enum ParsePort { MAX = 0, PI, LATCH, PO, AND, OLD_PARSE_PORTS,
                  TOTAL_PARSE_PORTS };
 
 public:
-	AigParser() {}
+	AigParser(): mapBegin(0), mapSize(0) {}
 	virtual ~AigParser() {}
 
 	AigNtk* parseAig(const char*);
 
 protected:
-	ifstream                  inFile;
+	// The file is mapped into memory, and each line is a view into the mapping
+	char*                     mapBegin;
+	size_t                    mapSize;
+	string                    fileData;
+	const char*               curPtr;
+	const char*               endPtr;
+	bool                      reachEOF;
 	unsigned                  lineNo;
 	unsigned                  oldColNo;
 	unsigned                  colNo;
-	string                    buffer;
+	string_view               buffer;
 	string                    errStr;
 	unsigned                  errInt;
 	AigGate*                  errGate;
@@ -104,7 +111,7 @@ protected:
 	bool checkGate(unsigned&, const string&);
 	bool checkDef(bool, const string&);
 	bool readOneLine();
-	bool isEOF()const { return inFile.eof(); }
+	bool isEOF()const { return reachEOF; }
 	bool checkEOF() { return isEOF() ? (errStr = "a newline character", parseError(UNEXPECTED_EOF)) : true; }
 	bool getUInt(bool, unsigned&, const string&);
 	bool getErrorToken();
@@ -120,7 +127,7 @@ protected:
 	void resetColNo() { colNo = 0; }
 	void setOldColNo() { oldColNo = colNo; }
 	void incLineNo() { lineNo += 1; }
-	void closeFile() { inFile.close(); }
+	void closeFile();
 	void setErrStr() { errStr = buffer.substr(oldColNo, colNo - oldColNo); setColNo(); }
 };
 
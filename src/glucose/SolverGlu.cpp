@@ -136,6 +136,7 @@ Solver::Solver() :
   , conflict_budget    (-1)
   , propagation_budget (-1)
   , asynch_interrupt   (false)
+  , stop_flag          (NULL) //added by 54ff
   , incremental(opt_incremental)
   , nbVarsInitialFormula(INT32_MAX)
 {
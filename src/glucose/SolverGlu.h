@@ -29,6 +29,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Glucose_Solver_h
 #define Glucose_Solver_h
 
+#include <atomic> //added by 54ff
+
 #include "VecGlu.h"
 #include "HeapGlu.h"
 #include "AlgGlu.h"
@@ -66,6 +68,7 @@ public:
     // Solving:
     //
     bool    simplify     ();                        // Removes already satisfied clauses.
+    bool    simplifyNow  () { simpDB_props = 0; return simplify(); } // Removes them regardless of the last simplification.
     bool    solve        (const vec<Lit>& assumps); // Search for a model that respects a given set of assumptions.
     lbool   solveLimited (const vec<Lit>& assumps); // Search for a model that respects a given set of assumptions (With resource constraints).
     bool    solve        ();                        // Search without assumptions.
@@ -116,6 +119,7 @@ public:
     void    budgetOff();
     void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void    clearInterrupt();     // Clear interrupt indicator flag.
+    void    setStopFlag(const std::atomic<bool>* f) { stop_flag = f; } //added by 54ff, a flag raised by another thread to give up the search
 
     // Memory managment:
     //
@@ -266,6 +270,7 @@ protected:
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
     bool                asynch_interrupt;
+    const std::atomic<bool>* stop_flag; //added by 54ff
 
 
     // Variables added for incremental mode
@@ -422,6 +427,7 @@ inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = decision_budget = -1; } //added by 54ff
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
+           (stop_flag == NULL || !stop_flag->load(std::memory_order_relaxed)) && //added by 54ff
            (conflict_budget    < 0 || conflicts < (uint64_t)conflict_budget) &&
            (propagation_budget < 0 || propagations < (uint64_t)propagation_budget) &&
            (decision_budget    < 0 || decisions < (uint64_t)decision_budget); } //added by 54ff
@@ -684,7 +684,7 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
         }else{
             // NO CONFLICT
 
-            if (nof_conflicts >= 0 && conflictC >= nof_conflicts){
+            if (nof_conflicts >= 0 && conflictC >= nof_conflicts || stopped()){ //added by 54ff
                 // Reached bound on number of conflicts:
                 progress_estimate = progressEstimate();
                 cancelUntil(root_level);
@@ -811,6 +811,7 @@ bool Solver::solve(const vec<Lit>& assumps)
             fflush(stdout);
         }
         status = search((int)nof_conflicts, (int)nof_learnts, params);
+        if (stopped()) break; //added by 54ff
         nof_conflicts *= 1.5;
         nof_learnts   *= 1.1;
     }
@@ -20,6 +20,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat114_Solver_h
 #define Minisat114_Solver_h
 
+#include <atomic> //added by 54ff
+
 #include "SolverTypes114.h"
 #include "VarOrder114.h"
 #include "Proof114.h"
@@ -138,6 +140,7 @@ public:
              , expensive_ccmin  (true)
              , proof            (NULL)
              , verbosity        (0)
+             , stop_flag        (NULL) //added by 54ff
              , progress_estimate(0)
              , conflict_id      (ClauseId_NULL)
              {
@@ -175,6 +178,8 @@ public:
     bool            expensive_ccmin;    // Controls conflict clause minimization. TRUE by default.
     Proof*          proof;              // Set this directly after constructing 'Solver' to enable proof logging. Initialized to NULL.
     int             verbosity;          // Verbosity level. 0=silent, 1=some progress report, 2=everything
+    const std::atomic<bool>* stop_flag; // added by 54ff, a flag raised by another thread to give up the search
+    bool            stopped() const { return stop_flag != NULL && stop_flag->load(std::memory_order_relaxed); } //added by 54ff
 
     // Problem specification:
     //
@@ -189,6 +194,7 @@ public:
     //
     bool    okay() { return ok; }       // FALSE means solver is in an conflicting state (must never be used again!)
     void    simplifyDB();
+    void    simplifyDBNow() { simpDB_props = 0; simplifyDB(); }   // Remove satisfied clauses regardless of the last simplification.
     bool    solve(const vec<Lit>& assumps);
     bool    solve() { vec<Lit> tmp; return solve(tmp); }
 
@@ -18,57 +18,469 @@ const lbool l_True  = { 0 };
 const lbool l_False = { 1 };
 const lbool l_Undef = { 2 };
 
+thread_local const atomic<bool>* CirSolver::threadStop = 0;
+
+CirCutMap::CirCutMap(AigNtk* ntk)
+: gateToCut (ntk->getMaxGateNum(), MAX_UNSIGNED)
+{
+	vector<AigAnd*> dfsList;
+	if(!ntk->checkCombLoop(false, dfsList))
+		return;
+	AigCutter cutter(ntk, 4, 10);
+
+	const size_t M = ntk->getMaxGateNum();
+	vector<unsigned> fanOutNum;
+	CirSolver::getFanOutNum(ntk, fanOutNum);
+
+	// Area flow: the clauses of the cut, plus the flow of the leaves shared by their fanouts
+	vector<double> flow(M, 0.0);
+	cutList.reserve(dfsList.size());
+	for(const AigAnd* a: dfsList)
+	{
+		const AigGateID id = a->getGateID();
+		const AigCut& unitCut = cutter.getCut(id, 0);
+		const bool merged = unitCut.numLeaves != 1 || unitCut.leaves[0] != id;
+		const AigCut* bestCut = 0;
+		double bestFlow = 0.0;
+		for(unsigned i = merged ? 0 : 1, N = cutter.getCutNum(id); i < N; ++i)
+		{
+			const AigCut& c = cutter.getCut(id, i);
+			double f = getMinSop(c.truthTable).size() + getMinSop(c.truthTable ^ 0xFFFF).size();
+			for(unsigned j = 0; j < c.numLeaves; ++j)
+				f += flow[c.leaves[j]] / (fanOutNum[c.leaves[j]] == 0 ? 1 : fanOutNum[c.leaves[j]]);
+			if(bestCut == 0 || f < bestFlow)
+				bestCut = &c, bestFlow = f;
+		}
+		assert(bestCut != 0);
+		flow[id] = bestFlow;
+
+		Cut cut;
+		for(unsigned j = 0; j < bestCut->numLeaves; ++j)
+			cut.leaves[j] = bestCut->leaves[j];
+		cut.leafNum   = bestCut->numLeaves;
+		cut.cubeBegin = cubeArr.size();
+		const vector<uint8_t>& onSop = getMinSop(bestCut->truthTable);
+		cubeArr.insert(cubeArr.end(), onSop.begin(), onSop.end());
+		const vector<uint8_t>& offSop = getMinSop(bestCut->truthTable ^ 0xFFFF);
+		cubeArr.insert(cubeArr.end(), offSop.begin(), offSop.end());
+		cut.onNum   = onSop.size();
+		cut.cubeNum = onSop.size() + offSop.size();
+		gateToCut[id] = cutList.size();
+		cutList.push_back(cut);
+	}
+}
+
+/*
+	Exact minimum SOP of a 4-input function
+	The primes are collected from the 81 cubes, and the cover is searched by branching on
+	the primes covering the first uncovered minterm, with the bound of the best cover so far
+*/
+const vector<uint8_t>&
+CirCutMap::getMinSop(unsigned truth)
+{
+	if(auto it = sopCache.find(truth); it != sopCache.end())
+		return it->second;
+
+	auto getMinterm = [](unsigned cube)
+	{
+		unsigned mint = 0;
+		for(unsigned x = 0; x < 16; ++x)
+			if((x & cube & 0xF) == (cube >> 4))
+				mint |= 1 << x;
+		return mint;
+	};
+	vector<pair<uint8_t, unsigned>> implicant;
+	for(unsigned mask = 0; mask < 16; ++mask)
+		for(unsigned value = mask; true; value = (value - 1) & mask)
+		{
+			const uint8_t cube = mask | (value << 4);
+			if(const unsigned mint = getMinterm(cube); (mint & ~truth) == 0)
+				implicant.emplace_back(cube, mint);
+			if(value == 0) break;
+		}
+	vector<pair<uint8_t, unsigned>> prime;
+	for(const auto& [cube, mint]: implicant)
+	{
+		bool isPrime = true;
+		for(const auto& [cube2, mint2]: implicant)
+			if(mint2 != mint && (mint & ~mint2) == 0)
+				{ isPrime = false; break; }
+		if(isPrime) prime.emplace_back(cube, mint);
+	}
+
+	vector<uint8_t> best, cur;
+	size_t bestNum = prime.size() + 1;
+	auto search = [&](auto& self, unsigned left) -> void
+	{
+		if(left == 0)
+			{ best = cur; bestNum = cur.size(); return; }
+		if(cur.size() + 1 >= bestNum)
+			return;
+		const unsigned x = __builtin_ctz(left);
+		for(const auto& [cube, mint]: prime)
+			if(mint & (1 << x))
+				cur.push_back(cube),
+				self(self, left & ~mint),
+				cur.pop_back();
+	};
+	search(search, truth & 0xFFFF);
+	return sopCache[truth] = best;
+}
+
+CirCnfTemplate::CirCnfTemplate(AigNtk* ntk, const CirCutMap* sharedCutMap)
+: gateToSlot (ntk->getMaxGateNum(), MAX_UNSIGNED)
+, slotCls    (1, 0)
+, clsBegin   (1, 0)
+{
+	// Under the cut-based encoding, only the roots of the cover get slots
+	CirCutMap* ownCutMap = sharedCutMap == 0 ? newCutMap(ntk) : 0;
+	const CirCutMap* cutMap = sharedCutMap != 0 ? sharedCutMap : ownCutMap;
+	// The latches at level L come first, then the cones of the latch inputs in DFS order
+	const size_t L = ntk->getLatchNum();
+	for(size_t i = 0; i < L; ++i)
+		addSlot(ntk->getLatchID(i), false),
+		slotCls.push_back(getClsNum());
+	vector<pair<AigGateID, bool>> dfsStack;
+	for(size_t i = 0; i < L; ++i)
+	{
+		dfsStack.emplace_back(ntk->getLatchNorm(i)->getFanIn0ID(), false);
+		while(!dfsStack.empty())
+		{
+			auto [id, expanded] = dfsStack.back();
+			if(gateToSlot[id] != MAX_UNSIGNED)
+				{ dfsStack.pop_back(); continue; }
+			const AigGate* g = ntk->getGate(id);
+			const bool isCut = g->getGateType() == AIG_AND && cutMap != 0 && cutMap->isMapped(id);
+			if(g->getGateType() == AIG_AND && !expanded)
+			{
+				dfsStack.back().second = true;
+				if(isCut)
+					for(unsigned j = cutMap->getLeafNum(id); j-- > 0;)
+						dfsStack.emplace_back(cutMap->getLeaf(id, j), false);
+				else
+					dfsStack.emplace_back(g->getFanIn1ID(), false),
+					dfsStack.emplace_back(g->getFanIn0ID(), false);
+				continue;
+			}
+			dfsStack.pop_back();
+			addSlot(id, false);
+			if(isCut)
+				addCutCls(*cutMap, id);
+			else if(g->getGateType() == AIG_AND)
+			{
+				const int F = getTLit(id, false);
+				const int A = getTLit(g->getFanIn0ID(), g->isFanIn0Inv());
+				const int B = getTLit(g->getFanIn1ID(), g->isFanIn1Inv());
+				addCls(F ^ 1, A);
+				addCls(F ^ 1, B);
+				addCls(F, A ^ 1, B ^ 1);
+			}
+			else if(g->getGateType() == AIG_CONST0)
+				addCls(getTLit(id, true));
+			slotCls.push_back(getClsNum());
+		}
+	}
+
+	// The slots of the latches at level L+1 come last,
+	// and a latch may feed another latch, so get the inputs first
+	vector<int> latchIn(L);
+	for(size_t i = 0; i < L; ++i)
+		latchIn[i] = getTLit(ntk->getLatchNorm(i)->getFanIn0ID(), ntk->getLatchNorm(i)->isFanIn0Inv());
+	for(size_t i = 0; i < L; ++i)
+	{
+		const AigGate* g = ntk->getLatchNorm(i);
+		const int G = latchIn[i];
+		addSlot(g->getGateID(), true);
+		const int F = getTLit(g->getGateID(), false);
+		addCls(F, G ^ 1);
+		addCls(F ^ 1, G);
+		slotCls.push_back(getClsNum());
+	}
+	delete ownCutMap;
+}
+
+void
+CirCnfTemplate::addCutCls(const CirCutMap& cutMap, AigGateID id)
+{
+	const int F = getTLit(id, false);
+	for(unsigned k = 0, n = cutMap.getClsNum(id); k < n; ++k)
+	{
+		const unsigned cube = cutMap.getCube(id, k);
+		litArr.push_back(cutMap.isOnCube(id, k) ? F : F ^ 1);
+		for(unsigned i = 0, L = cutMap.getLeafNum(id); i < L; ++i)
+			if(cube & (1 << i))
+				litArr.push_back(getTLit(cutMap.getLeaf(id, i), (cube >> (4 + i)) & 1));
+		clsBegin.push_back(litArr.size());
+	}
+}
+
+void
+CirCnfTemplate::addSlot(AigGateID id, bool nextLevel)
+{
+	gateToSlot[id] = slotGate.size();
+	slotGate.push_back(id);
+	slotNext.push_back(nextLevel);
+}
+
+void
+CirSolver::loadCNF(const CirCnfTemplate& cnf, size_t level)
+{
+	// The gates converted before keep their variables and clauses
+	checkVarList();
+	vector<Var> slotVar(cnf.getSlotNum());
+	for(size_t s = 0, S = cnf.getSlotNum(); s < S; ++s)
+	{
+		const AigGateID id = cnf.slotGate[s];
+		const size_t    l  = cnf.slotNext[s] ? level + 1 : level;
+		const bool      isNew = !isConverted(id, l);
+		if(isNew) setVar(id, l);
+		// The template uses the gate in both phases
+		else if(getPhase(id, l) != PHASE_BOTH)
+			convertToCNFPol(id, l, PHASE_BOTH);
+		slotVar[s] = getVarInt(id, l);
+		if(isNew)
+			for(unsigned c = cnf.slotCls[s]; c < cnf.slotCls[s+1]; ++c)
+			{
+				for(unsigned i = cnf.clsBegin[c]; i < cnf.clsBegin[c+1]; ++i)
+					litBuf.emplace_back(slotVar[cnf.litArr[i] >> 1], cnf.litArr[i] & 1);
+				lenBuf.push_back(cnf.clsBegin[c+1] - cnf.clsBegin[c]);
+			}
+	}
+	flushClause();
+}
+
 void
 CirSolver::convertToCNFInt(AigGateID id, size_t level)
 {
 	//trivial Tseitin transformation
+	//the fanins are converted first with an explicit stack, so deep cones do not overflow the call stack
+	//the gates are read from the flat view of the network
 	if(isConverted(id, level))
 		return;
-	switch(AigGate* g = ntk->getGate(id); g->getGateType())
+	const AigFlatView& view = ntk->getFlatView();
+	cnfStack.push_back({ id, 0, level });
+	while(!cnfStack.empty())
 	{
-		case AIG_PI:
-			setVar(id, level);
-			break;
+		CnfTask& t = cnfStack.back();
+		const AigGateType type = view.getGateType(t.id);
+		// The fanins of an AND gate in the cover are the leaves of its cut
+		const bool isCut = type == AIG_AND && cutMap != 0 && cutMap->isMapped(t.id);
+		const unsigned inNum = isCut ? cutMap->getLeafNum(t.id) :
+		                       type == AIG_AND ? 2 : (type == AIG_PO || (type == AIG_LATCH && t.level > 0)) ? 1 : 0;
+		if(t.next < inNum)
+		{
+			const AigGateID inId    = isCut ? cutMap->getLeaf(t.id, t.next) : getGateID(t.next == 0 ? view.getFanIn0(t.id) : view.getFanIn1(t.id));
+			const size_t    inLevel = type == AIG_LATCH ? t.level - 1 : t.level;
+			t.next += 1;
+			if(!isConverted(inId, inLevel))
+				cnfStack.push_back({ inId, 0, inLevel });
+			continue;
+		}
+
+		const AigGateID curId = t.id;
+		const size_t    l     = t.level;
+		cnfStack.pop_back();
+		if(isConverted(curId, l))
+			continue;
+		setVar(curId, l);
+		switch(type)
+		{
+			case AIG_PI:
+				break;
+
+			// The same clauses as convertBuf and convertAnd, but buffered
+			case AIG_LATCH:
+			case AIG_PO:
+				if(type == AIG_PO || l > 0)
+				{
+					const AigGateLit in = view.getFanIn0(curId);
+					const Lit F(getVarInt(curId, l), false);
+					const Lit G(getVarInt(getGateID(in), type == AIG_LATCH ? l-1 : l), isInv(in));
+					bufClause( F, ~G);
+					bufClause(~F,  G);
+				}
+				break;
+
+			case AIG_AND:
+				if(isCut)
+					convertCut(curId, l);
+				else
+				{
+					const AigGateLit in0 = view.getFanIn0(curId), in1 = view.getFanIn1(curId);
+					const Lit F(getVarInt(curId, l), false);
+					const Lit A(getVarInt(getGateID(in0), l), isInv(in0));
+					const Lit B(getVarInt(getGateID(in1), l), isInv(in1));
+					bufClause(~F, A);
+					bufClause(~F, B);
+					bufClause(F, ~A, ~B);
+				}
+				break;
+
+			case AIG_CONST0:
+				bufClause(Lit(getVarInt(curId, l), true));
+				break;
+
+			default: assert(false);
+		}
+	}
+}
 
-		case AIG_LATCH:
-			if(level > 0)
+/*
+	Polarity-aware encoding (Plaisted-Greenbaum)
+	A gate only gets the clauses of the phases it is needed in, and the fanins get the phases they are needed in by the clauses
+	The phases emitted are kept per gate and level, so a gate needed in another phase later only gets the missing half
+*/
+void
+CirSolver::convertToCNFPol(AigGateID id, size_t level, uint8_t phase)
+{
+	getPhaseVar(id, level);
+	cnfStack.push_back({ id, phase, level });
+	while(!cnfStack.empty())
+	{
+		const CnfTask t = cnfStack.back();
+		cnfStack.pop_back();
+		const uint8_t need = t.next & ~getPhase(t.id, t.level);
+		if(need == 0)
+			continue;
+		setPhase(t.id, t.level, getPhase(t.id, t.level) | need);
+		const AigGate* g = ntk->getGate(t.id);
+		switch(g->getGateType())
+		{
+			case AIG_LATCH:
+			case AIG_PO:
 			{
-				AigGateID inId = g->getFanIn0ID();
-				convertToCNFInt(inId, level-1);
-				setVar(id, level);
-				convertBuf(getVarInt(id,   level),   false,
-				           getVarInt(inId, level-1), g->isFanIn0Inv());
+				// The latches at level 0 are free and have both phases
+				const Lit F(getVarInt(t.id, t.level), false);
+				const Lit G = getPhaseLit(makeToLit(g->getFanIn0ID(), g->isFanIn0Inv()), g->getGateType() == AIG_LATCH ? t.level - 1 : t.level, need);
+				if(need & PHASE_POS) bufClause(~F,  G);
+				if(need & PHASE_NEG) bufClause( F, ~G);
+				break;
 			}
-			else setVar(id, level);
-			break;
 
-		case AIG_PO:
-			{
-				AigGateID inId = g->getFanIn0ID();
-				convertToCNFInt(inId, level);
-				setVar(id, level);
-				convertBuf(getVarInt(id,   level), false,
-				           getVarInt(inId, level), g->isFanIn0Inv());
-			} break;
-
-		case AIG_AND:
-			{
-				AigGateID inId0 = g->getFanIn0ID();
-				AigGateID inId1 = g->getFanIn1ID();
-				convertToCNFInt(inId0, level);
-				convertToCNFInt(inId1, level);
-				setVar(id, level);
-				convertAnd(getVarInt(id,    level), false,
-				           getVarInt(inId0, level), g->isFanIn0Inv(),
-				           getVarInt(inId1, level), g->isFanIn1Inv());
-			} break;
-
-		case AIG_CONST0:
-			setVar(id, level);
-			addClause(Lit(getVarInt(id, level), true));
-			break;
-
-		default: assert(false);
+			case AIG_AND:
+				convertAndPol(t.id, t.level, need);
+				break;
+
+			default: assert(false);
+		}
+	}
+}
+
+Var
+CirSolver::getPhaseVar(AigGateID id, size_t level)
+{
+	if(!isConverted(id, level))
+	{
+		setVar(id, level);
+		const AigGateType type = ntk->getGate(id)->getGateType();
+		if(type == AIG_CONST0)
+			bufClause(Lit(getVarInt(id, level), true));
+		else if(type == AIG_AND || type == AIG_PO || (type == AIG_LATCH && level > 0))
+			setPhase(id, level, 0);
+	}
+	return getVarInt(id, level);
+}
+
+Lit
+CirSolver::getPhaseLit(AigGateLit lit, size_t level, uint8_t phase)
+{
+	// The phase of an inverted fanin is flipped
+	const AigGateID id = getGateID(lit);
+	const Var v = getPhaseVar(id, level);
+	if(isInv(lit))
+		phase = ((phase & PHASE_POS) << 1) | ((phase & PHASE_NEG) >> 1);
+	if(phase & ~getPhase(id, level))
+		cnfStack.push_back({ id, phase, level });
+	return Lit(v, isInv(lit));
+}
+
+/*
+	F = (S & T)' & (S' & E)' = S ? T' : E' if the two fanins are inverted single-fanout AND gates sharing S in opposite phases,
+	and F = S ^ E' if T = E' as well
+	Otherwise the non-inverted single-fanout AND gates in the fanin cone are merged into one wide AND
+*/
+void
+CirSolver::convertAndPol(AigGateID id, size_t level, uint8_t need)
+{
+	const AigGate* g = ntk->getGate(id);
+	const Lit F(getVarInt(id, level), false);
+	auto getLit = [](const AigGate* a, unsigned i) { return makeToLit(a->getFanInID(i), a->isFanInInv(i)); };
+	if(g->isFanIn0Inv() && g->isFanIn1Inv() && isCollapsible(g->getFanIn0ID(), level) && isCollapsible(g->getFanIn1ID(), level))
+	{
+		const AigGate* x = g->getFanIn0Ptr();
+		const AigGate* y = g->getFanIn1Ptr();
+		for(unsigned i = 0; i < 2; ++i)
+			for(unsigned j = 0; j < 2; ++j)
+				if(getLit(x, i) == (getLit(y, j) ^ 1))
+				{
+					const AigGateLit s = getLit(x, i), t = getLit(x, 1 - i) ^ 1, e = getLit(y, 1 - j) ^ 1;
+					const Lit S = getPhaseLit(s, level, PHASE_BOTH);
+					if(t == (e ^ 1))
+					{
+						const Lit E = getPhaseLit(e, level, PHASE_BOTH);
+						if(need & PHASE_POS) bufClause(~F,  S,  E), bufClause(~F, ~S, ~E);
+						if(need & PHASE_NEG) bufClause( F, ~S,  E), bufClause( F,  S, ~E);
+					}
+					else
+					{
+						const Lit T = getPhaseLit(t, level, need);
+						const Lit E = getPhaseLit(e, level, need);
+						if(need & PHASE_POS) bufClause(~F, ~S,  T), bufClause(~F, S,  E);
+						if(need & PHASE_NEG) bufClause( F, ~S, ~T), bufClause( F, S, ~E);
+					}
+					return;
+				}
+	}
+
+	vector<Lit> cls;
+	vector<AigGateLit> inStack = { getLit(g, 1), getLit(g, 0) };
+	while(!inStack.empty())
+	{
+		const AigGateLit lit = inStack.back();
+		inStack.pop_back();
+		if(!isInv(lit) && isCollapsible(getGateID(lit), level))
+		{
+			const AigGate* a = ntk->getGate(getGateID(lit));
+			inStack.push_back(getLit(a, 1));
+			inStack.push_back(getLit(a, 0));
+		}
+		else cls.push_back(getPhaseLit(lit, level, need));
+	}
+	if(need & PHASE_POS)
+		for(const Lit& L: cls)
+			bufClause(~F, L);
+	if(need & PHASE_NEG)
+	{
+		for(Lit& L: cls) L.flip();
+		cls.push_back(F);
+		bufClause(cls);
+	}
+}
+
+void
+CirSolver::getFanOutNum(AigNtk* ntk, vector<unsigned>& fanOutNum)
+{
+	const size_t M = ntk->getMaxGateNum();
+	fanOutNum.assign(M, 0);
+	for(size_t i = 0; i < M; ++i)
+		if(const AigGate* g = ntk->getGate(i); g != 0)
+			for(unsigned j = 0, n = g->getFanInNum(); j < n; ++j)
+				fanOutNum[g->getFanInID(j)] += 1;
+}
+
+void
+CirSolver::convertCut(AigGateID id, size_t level)
+{
+	const Var f = getVarInt(id, level);
+	for(unsigned k = 0, n = cutMap->getClsNum(id); k < n; ++k)
+	{
+		const unsigned cube = cutMap->getCube(id, k);
+		const size_t begin = litBuf.size();
+		litBuf.emplace_back(f, !cutMap->isOnCube(id, k));
+		for(unsigned i = 0, L = cutMap->getLeafNum(id); i < L; ++i)
+			if(cube & (1 << i))
+				litBuf.emplace_back(getVarInt(cutMap->getLeaf(id, i), level), (cube >> (4 + i)) & 1);
+		lenBuf.push_back(litBuf.size() - begin);
 	}
 }
 
@@ -161,27 +573,21 @@ CirSolver::convertOr(Var f, bool invF, const vector<Lit>& litList)
 }
 
 void
-CirSolver::techMapToCNF()
-{
-	AigCutter fourCut(ntk, 4, 10);
-}
-
-void
-CirSolver::reportLatch(size_t idx, size_t level)const
+CirSolver::reportLatch(ostream& os, size_t idx, size_t level)const
 {
-	cout << idx << ": ";
+	os << idx << ": ";
 	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
-		cout << getValueChar(ntk->getLatchID(i), level);
-	cout << endl;
+		os << getValueChar(ntk->getLatchID(i), level);
+	os << endl;
 }
 
 void
-CirSolver::reportPI(size_t idx, size_t level)const
+CirSolver::reportPI(ostream& os, size_t idx, size_t level)const
 {
-	cout << idx << ": ";
+	os << idx << ": ";
 	for(size_t i = 0, I = ntk->getInputNum(); i < I; ++i)
-		cout << getValueChar(ntk->getInputID(i), level);
-	cout << endl;
+		os << getValueChar(ntk->getInputID(i), level);
+	os << endl;
 }
 
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 #ifndef HEHE_CIRSOLVER_H
 #define HEHE_CIRSOLVER_H
 
+#include <unordered_map>
+#include <atomic>
 #include "aigNtk.h"
 
 namespace _54ff
@@ -49,26 +51,150 @@ private:
 
 extern const lbool l_True, l_False, l_Undef;
 
+enum CnfType
+{
+	CNF_TYPE_TSEITIN = 0,
+	CNF_TYPE_CUT,
+	CNF_TYPE_POLARITY,
+	CNF_TYPE_TOTAL
+};
+
+extern const string cnfName[CNF_TYPE_TOTAL];
+
+// Thrown by a solve given up through the stop flag, so the caller never takes it as UNSAT
+class SolverStop {};
+
+extern CnfType curCnfType;
+
+/*
+	Cover of the AND gates by 4-feasible cuts for the cut-based CNF encoding
+	Each gate takes the cut of the least area flow, where the area of a cut is the number of its clauses,
+	i.e. the cubes of the minimum SOP of the cut function and of its complement
+	Only the gates being converted, i.e. the roots of the cover, get variables,
+	and a leaf of a root becomes a root as well
+	The gates out of the DFS order of the network, e.g. those added later, are not mapped
+	A checker builds one cover by newCutMap and shares it with its solvers and its template
+*/
+class CirCutMap
+{
+public:
+	CirCutMap(AigNtk*);
+
+	bool isMapped(AigGateID id)const { return id < gateToCut.size() && gateToCut[id] != MAX_UNSIGNED; }
+
+	unsigned  getLeafNum(AigGateID id)const             { return getCut(id).leafNum; }
+	AigGateID getLeaf   (AigGateID id, unsigned i)const { return getCut(id).leaves[i]; }
+	unsigned  getClsNum (AigGateID id)const             { return getCut(id).cubeNum; }
+
+	// Clause k of a gate is "gate + cube'" for a cube of the on-set, or "gate' + cube'" for the off-set
+	// A cube keeps the mask of the leaves in bits 0-3 and their values in bits 4-7
+	bool     isOnCube(AigGateID id, unsigned k)const { return k < getCut(id).onNum; }
+	unsigned getCube (AigGateID id, unsigned k)const { return cubeArr[getCut(id).cubeBegin + k]; }
+
+private:
+	struct Cut
+	{
+		AigGateID  leaves[4];
+		unsigned   leafNum   : 3;
+		unsigned   onNum     : 5;
+		unsigned   cubeNum   : 5;
+		unsigned   cubeBegin;
+	};
+
+	const Cut& getCut(AigGateID id)const { assert(isMapped(id)); return cutList[gateToCut[id]]; }
+	const vector<uint8_t>& getMinSop(unsigned);
+
+private:
+	vector<unsigned>  gateToCut;
+	vector<Cut>       cutList;
+	vector<uint8_t>   cubeArr;
+
+	unordered_map<unsigned, vector<uint8_t>>  sopCache;
+};
+
+// The cover of the network under the cut-based encoding, otherwise none
+inline CirCutMap* newCutMap(AigNtk* ntk) { return curCnfType == CNF_TYPE_CUT ? new CirCutMap(ntk) : 0; }
+
+/*
+	Flat CNF of the transition relation,
+	i.e. the latches at level L+1 from the latches and the inputs at level L.
+	The clauses refer to slots rather than variables,
+	so one template can be loaded to any solver at any level by CirSolver::loadCNF
+*/
+class CirCnfTemplate
+{
+friend class CirSolver;
+
+public:
+	CirCnfTemplate(AigNtk*, const CirCutMap* = 0);
+
+	size_t getSlotNum()const { return slotGate.size(); }
+	size_t getClsNum ()const { return clsBegin.size() - 1; }
+
+private:
+	void addSlot(AigGateID id, bool nextLevel);
+	void addCls (int p)               { litArr.push_back(p); clsBegin.push_back(litArr.size()); }
+	void addCls (int p, int q)        { litArr.push_back(p); addCls(q); }
+	void addCls (int p, int q, int r) { litArr.push_back(p); addCls(q, r); }
+	void addCutCls(const CirCutMap&, AigGateID);
+	int  getTLit(AigGateID id, bool inv)const { return int(gateToSlot[id] << 1) | int(inv); }
+
+private:
+	vector<unsigned>   gateToSlot; // slot of the gate at level L, or of the latch at level L+1
+	vector<AigGateID>  slotGate;
+	vector<bool>       slotNext;   // whether the slot is at level L+1
+	vector<unsigned>   slotCls;    // the clauses of slot s are [slotCls[s], slotCls[s+1])
+	vector<unsigned>   clsBegin;   // the literals of clause c are [clsBegin[c], clsBegin[c+1])
+	vector<int>        litArr;     // (slot << 1) | inv
+};
+
 class CirSolver
 {
-using VarLevelList = vector<vector<Var>>;
+using VarLevelList   = vector<vector<Var>>;
+using PhaseLevelList = vector<vector<uint8_t>>;
 
 public:
 	CirSolver(AigNtk* n)
 	: ntk        (n)
-	, idLvlToVar (ntk->getMaxGateNum()) {}
-	virtual ~CirSolver() {}
+	, idLvlToVar (ntk->getMaxGateNum())
+	, cutMap     (0)
+	, ownCutMap  (0)
+	, stopFlag   (threadStop) {}
+	virtual ~CirSolver() { delete ownCutMap; }
+
+	// Every solver created in the thread takes the flag, and its search gives up once the flag is raised
+	// e.g. by the portfolio when another engine settles the property
+	static void setThreadStop(const atomic<bool>* f) { threadStop = f; }
 
 	/*====================================*/
 
 	virtual void resetSolverInt() = 0;
-	void resetSolver() { idLvlToVar.clear(); clearAssump();
+	void resetSolver() { idLvlToVar.clear(); idLvlToPhase.clear(); clearAssump(); clearConflict();
 	                     idLvlToVar.resize(ntk->getMaxGateNum()); resetSolverInt(); }
 
+	// Drop the clauses satisfied at the top level, including the learned ones,
+	// e.g. the clauses guarded by the activation variables set to false
+	virtual void removeSatisfied() = 0;
+
 	/*====================================*/
 
-	void convertToCNF   (AigGateID id, size_t level) { checkVarList(); convertToCNFInt(id, level); }
+	static constexpr uint8_t PHASE_POS  = 1; // the clauses "gate' + ...", needed to assume or assert the gate as 1
+	static constexpr uint8_t PHASE_NEG  = 2; // the clauses "gate + ...", needed to assume or assert the gate as 0
+	static constexpr uint8_t PHASE_BOTH = 3;
+
+	// Only the polarity-aware encoding tells the phases apart, and a gate given one phase
+	// may only be assumed or asserted in it, and only its value in that phase is exact
+	void convertToCNF   (AigGateID id, size_t level)           { convertPhase(id, level, PHASE_BOTH); }
+	void convertToCNF   (AigGateID id, size_t level, bool inv) { convertPhase(id, level, inv ? PHASE_NEG : PHASE_POS); }
+	void convertPhase   (AigGateID id, size_t level, uint8_t phase) { checkVarList(); checkCutMap(); checkFanOut();
+	                                                                  if(curCnfType == CNF_TYPE_POLARITY) convertToCNFPol(id, level, phase);
+	                                                                  else convertToCNFInt(id, level);
+	                                                                  flushClause(); }
 	void convertToCNFInt(AigGateID, size_t);
+	void convertToCNFPol(AigGateID, size_t, uint8_t);
+	void convertCut(AigGateID, size_t);
+	void convertAndPol(AigGateID, size_t, uint8_t);
+	void loadCNF(const CirCnfTemplate&, size_t);
 
 	void convertAnd(Var, bool, Var, bool, Var, bool);
 	void convertXor(Var, bool, Var, bool, Var, bool);
@@ -86,8 +212,22 @@ public:
 	virtual void addClause(Lit, Lit, Lit)      = 0;
 	virtual void addClause(const vector<Lit>&) = 0;
 	virtual void addConflict()                 = 0;
-
-	void techMapToCNF();
+	// Clause c is the next lenArr[c] literals of litArr
+	virtual void addClauses(const vector<Lit>& litArr, const vector<unsigned>& lenArr) = 0;
+
+	// The clauses of a conversion are buffered, and handed to the backend in one call by flushClause
+	void bufClause(Lit p)                  { litBuf.push_back(p); lenBuf.push_back(1); }
+	void bufClause(Lit p, Lit q)           { litBuf.push_back(p); litBuf.push_back(q); lenBuf.push_back(2); }
+	void bufClause(Lit p, Lit q, Lit r)    { litBuf.push_back(p); litBuf.push_back(q); litBuf.push_back(r); lenBuf.push_back(3); }
+	void bufClause(const vector<Lit>& cls) { litBuf.insert(litBuf.end(), cls.begin(), cls.end()); lenBuf.push_back(cls.size()); }
+	void flushClause() { if(!lenBuf.empty()) { addClauses(litBuf, lenBuf); litBuf.clear(); lenBuf.clear(); } }
+
+	// A solver given no shared cover builds its own on the first conversion,
+	// so the solvers only loading a template never pay for it
+	void setCutMap(const CirCutMap* m) { assert(ownCutMap == 0); cutMap = m; }
+	void checkCutMap() { if(curCnfType == CNF_TYPE_CUT && cutMap == 0) cutMap = ownCutMap = new CirCutMap(ntk); }
+	void checkFanOut() { if(curCnfType == CNF_TYPE_POLARITY && fanOutNum.empty()) getFanOutNum(ntk, fanOutNum); }
+	static void getFanOutNum(AigNtk*, vector<unsigned>&);
 
 	/*====================================*/
 
@@ -105,12 +245,32 @@ public:
 	void checkVarList() { assert(ntk->getMaxGateNum() >= idLvlToVar.size());
 	                      idLvlToVar.resize(ntk->getMaxGateNum()); }
 
+	// The gates converted by the other encodings, or by loading a template, have both phases
+	uint8_t getPhase(AigGateID id, size_t level)const { return id < idLvlToPhase.size() && level < idLvlToPhase[id].size() ?
+	                                                           idLvlToPhase[id][level] : PHASE_BOTH; }
+	void    setPhase(AigGateID id, size_t level, uint8_t phase)
+	{
+		if(id >= idLvlToPhase.size())
+			idLvlToPhase.resize(idLvlToVar.size());
+		if(level >= idLvlToPhase[id].size())
+			idLvlToPhase[id].resize(level+1, PHASE_BOTH);
+		idLvlToPhase[id][level] = phase;
+	}
+	Var getPhaseVar(AigGateID, size_t);
+	Lit getPhaseLit(AigGateLit, size_t, uint8_t);
+	// A single-fanout AND gate without a variable is merged into its fanout
+	bool isCollapsible(AigGateID id, size_t level)const { return id < fanOutNum.size() && fanOutNum[id] == 1 && !isConverted(id, level) &&
+	                                                             ntk->getGate(id)->getGateType() == AIG_AND; }
+
 	bool isVarValid(Var v)const { return v > var_Undef && v < int(getVarNum()); }
 
 	/*====================================*/
 
-	virtual lbool getValue(Var v)const  = 0;
-	virtual bool inConflict(Var v)const = 0;
+	virtual lbool getValue(Var v)const = 0;
+
+	// Whether the assumption of the variable is in the final conflict of the last solve
+	// Each backend marks the conflict once when the solve is UNSAT, so a lookup takes constant time
+	bool inConflict(Var v)const { return size_t(v) < confMark.size() && confMark[v]; }
 
 	virtual unsigned getVarNum()const    = 0;
 	virtual unsigned getClsNum()const    = 0;
@@ -118,21 +278,25 @@ public:
 	virtual size_t getDecisionNum()const = 0;
 
 	lbool getValue(AigGateID id, size_t level)const { assert(isConverted(id, level)); return getValue(getVarInt(id, level)); }
-	bool getValueBool(AigGateID id, size_t level)const { return getValueBool(getVarInt(id, level)); }
+	// A CI dropped from the cuts by redundancy gets no variable, and any value of it is consistent
+	bool getValueBool(AigGateID id, size_t level)const { return isConverted(id, level) ? getValueBool(getVarInt(id, level))
+	                                                                                   : (assert(ntk->getGate(id)->isCI()), false); }
 	bool getValueBool(Var v)const { assert(getValue(v) != l_Undef); return getValue(v) == l_True; }
 	char getValueChar(AigGateID id, size_t level)const { if(Var v = getVar(id, level); v != var_Undef) return getValueChar(v); else return 'X'; }
 	char getValueChar(Var v)const { return getValue(v) == l_Undef ? '?' : (getValue(v) == l_True ? '1' : '0'); }
 	bool inConflict(AigGateID id, size_t level)const { return inConflict(getVarInt(id, level)); }
 
-	void reportLatch(size_t, size_t)const;
-	void reportPI   (size_t, size_t)const;
-	void reportTrace(size_t maxLevel) { for(size_t l = 0; l <= maxLevel; ++l) reportPI(l, l); }
+	void reportLatch(ostream&, size_t, size_t)const;
+	void reportPI   (ostream&, size_t, size_t)const;
+	void reportTrace(ostream& os, size_t maxLevel) { for(size_t l = 0; l <= maxLevel; ++l) reportPI(os, l, l); }
 
 	/*====================================*/
 
-	virtual void addAssump(Lit L) = 0;
-	virtual void clearAssump()    = 0;
-	virtual bool solve()          = 0;
+	// The assumptions are kept here rather than in the backend, so adding one is not a virtual call,
+	// and the backend takes all of them at once when solving
+	void addAssump(Lit L) { assump.push_back(L); }
+	void clearAssump()    { assump.clear(); }
+	virtual bool solve() = 0;
 
 	virtual void setConfLimit(size_t) = 0;
 	virtual void setDeciLimit(size_t) = 0;
@@ -140,13 +304,46 @@ public:
 	virtual lbool solveLimited()      = 0;
 
 	void addAssump(Var v, bool inv) { assert(isVarValid(v)); addAssump(Lit(v, inv)); }
-	void addAssump(AigGateID id, size_t level, bool inv) { assert(isConverted(id, level)); addAssump(getVarInt(id, level), inv); }
+	void addAssump(AigGateID id, size_t level, bool inv) { if(!isConverted(id, level)) { assert(ntk->getGate(id)->isCI()); convertToCNF(id, level); }
+	                                                       addAssump(getVarInt(id, level), inv); }
 	void addAssump(AigGateLit lit, size_t level) { addAssump(getGateID(lit), level, isInv(lit)); }
 	void addAssump(AigGateV gateV, size_t level) { addAssump(gateV.getGateID(), level, gateV.isInv()); }
 
 protected:
-	AigNtk*       ntk;
-	VarLevelList  idLvlToVar;
+	struct CnfTask
+	{
+		AigGateID  id;
+		unsigned   next;
+		size_t     level;
+	};
+
+	AigNtk*           ntk;
+	VarLevelList      idLvlToVar;
+	PhaseLevelList    idLvlToPhase; // the phases emitted by the polarity-aware encoding
+	vector<CnfTask>   cnfStack;
+	const CirCutMap*  cutMap;
+	CirCutMap*        ownCutMap;
+	vector<unsigned>  fanOutNum;
+	vector<Lit>       litBuf;
+	vector<unsigned>  lenBuf;
+	vector<Lit>       assump;
+
+	void clearConflict() { for(Var v: confList) confMark[v] = 0; confList.clear(); }
+	void markConflict(Var v)
+	{
+		if(size_t(v) >= confMark.size())
+			confMark.resize(max(size_t(v) + 1, 2 * confMark.size()), 0);
+		if(!confMark[v])
+			confMark[v] = 1, confList.push_back(v);
+	}
+
+	vector<uint8_t>   confMark;
+	vector<Var>       confList;
+
+	void checkStop()const { if(stopFlag != 0 && stopFlag->load(memory_order_relaxed)) throw SolverStop(); }
+
+	const atomic<bool>*  stopFlag;
+	static thread_local const atomic<bool>*  threadStop;
 };
 
 enum SolverType
@@ -181,7 +378,7 @@ template <>
 class SolverPtr<CirSolver>
 {
 public:
-	SolverPtr<CirSolver>(AigNtk* ntk): s(getSolver(ntk)) {}
+	SolverPtr<CirSolver>(AigNtk* ntk, const CirCutMap* cutMap = 0): s(getSolver(ntk)) { s->setCutMap(cutMap); }
 	~SolverPtr<CirSolver>() { delete s; }
 
 	CirSolver* operator->()const { return s; }
@@ -14,20 +14,30 @@ CirSolver* getSolver114(AigNtk* ntk) { return (new CirSolver114(ntk)); }
 void
 CirSolver114::addClause(const vector<Lit>& litList)
 {
-	M1::vec<M1::Lit> tmp;
-	tmp.capacity(litList.size());
+	clsTmp.clear();
 	for(const Lit& lit: litList)
-		tmp.push(toLit(lit));
-	solver->addClause(tmp);
+		clsTmp.push(toLit(lit));
+	solver->addClause(clsTmp);
 }
 
-bool
-CirSolver114::inConflict(Var v)const
+void
+CirSolver114::addClauses(const vector<Lit>& litArr, const vector<unsigned>& lenArr)
+{
+	const Lit* lit = litArr.data();
+	for(unsigned len: lenArr)
+	{
+		clsTmp.clear();
+		for(const Lit* end = lit + len; lit != end; ++lit)
+			clsTmp.push(toLit(*lit));
+		solver->addClause(clsTmp);
+	}
+}
+
+void
+CirSolver114::loadConflict()
 {
 	for(int i = 0; i < solver->conflict.size(); ++i)
-		if(M1::var(solver->conflict[i]) == v)
-			return true;
-	return false;
+		markConflict(M1::var(solver->conflict[i]));
 }
 
 AigGateV
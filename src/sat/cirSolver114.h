@@ -27,12 +27,13 @@ class CirSolver114 : public CirSolver
 public:
 	CirSolver114(AigNtk* n)
 	: CirSolver  (n)
-	, solver     (new M1::Solver) {}
+	, solver     (new M1::Solver) { solver->stop_flag = stopFlag; }
 	~CirSolver114() { delete solver; }
 
 	/*====================================*/
 
-	void resetSolverInt() { delete solver; solver = new M1::Solver; }
+	void resetSolverInt() { delete solver; solver = new M1::Solver; solver->stop_flag = stopFlag; }
+	void removeSatisfied() { solver->simplifyDBNow(); }
 
 	/*====================================*/
 
@@ -41,6 +42,7 @@ public:
 	void addClause(Lit p, Lit q, Lit r) { solver->addTernary(toLit(p), toLit(q), toLit(r)); }
 	void addClause(const vector<Lit>&);
 	void addConflict()                  { solver->addClause(solver->conflict); }
+	void addClauses(const vector<Lit>&, const vector<unsigned>&);
 
 	/*====================================*/
 
@@ -49,7 +51,6 @@ public:
 	/*====================================*/
 
 	lbool getValue(Var v)const { return toLBool(solver->model[v]); }
-	bool inConflict(Var v)const;
 
 	unsigned getVarNum()const { return solver->nVars(); }
 	unsigned getClsNum()const { return solver->nClauses(); }
@@ -58,18 +59,22 @@ public:
 
 	/*====================================*/
 
-	void addAssump(Lit L) { assump.push(toLit(L)); }
-	void clearAssump() { assump.clear(); }
-	bool solve() { return solver->solve(assump); }
+	bool solve() { loadAssump(); clearConflict();
+	               if(solver->solve(assumpVec)) return true;
+	               checkStop(); loadConflict(); return false; }
 
 	void setConfLimit(size_t) { /* Dummy */ }
 	void setDeciLimit(size_t) { /* Dummy */ }
 	void resetLimit()         { /* Dummy */ }
 	lbool solveLimited() { return solve() ? l_True : l_False; }
 
+	void loadAssump() { assumpVec.clear(); for(const Lit& L: assump) assumpVec.push(toLit(L)); }
+	void loadConflict();
+
 protected:
 	M1::Solver*       solver;
-	M1::vec<M1::Lit>  assump;
+	M1::vec<M1::Lit>  assumpVec;
+	M1::vec<M1::Lit>  clsTmp;
 };
 
 class CirSolver114Proof : public CirSolver114
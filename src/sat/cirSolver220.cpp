@@ -14,20 +14,30 @@ CirSolver* getSolver220(AigNtk* ntk) { return (new CirSolver220(ntk)); }
 void
 CirSolver220::addClause(const vector<Lit>& litList)
 {
-	M2::vec<M2::Lit> tmp;
-	tmp.capacity(litList.size());
+	clsTmp.clear();
 	for(const Lit& lit: litList)
-		tmp.push_(toLit(lit));
-	solver->addClause_(tmp);
+		clsTmp.push(toLit(lit));
+	solver->addClause_(clsTmp);
 }
 
-bool
-CirSolver220::inConflict(Var v)const
+void
+CirSolver220::addClauses(const vector<Lit>& litArr, const vector<unsigned>& lenArr)
+{
+	const Lit* lit = litArr.data();
+	for(unsigned len: lenArr)
+	{
+		clsTmp.clear();
+		for(const Lit* end = lit + len; lit != end; ++lit)
+			clsTmp.push(toLit(*lit));
+		solver->addClause_(clsTmp);
+	}
+}
+
+void
+CirSolver220::loadConflict()
 {
 	for(int i = 0; i < solver->conflict.size(); ++i)
-		if(M2::var(solver->conflict[i]) == v)
-			return true;
-	return false;
+		markConflict(M2::var(solver->conflict[i]));
 }
 
 }
\ No newline at end of file
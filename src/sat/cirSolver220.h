@@ -10,6 +10,11 @@
 #include "cirSolver.h"
 #include "Solver220.h"
 
+// MiniSAT names the constants of its own lbool by macros, which would hide those of _54ff
+#undef l_True
+#undef l_False
+#undef l_Undef
+
 namespace M2 = Minisat220;
 
 namespace _54ff
@@ -23,12 +28,13 @@ class CirSolver220 : public CirSolver
 public:
 	CirSolver220(AigNtk* n)
 	: CirSolver  (n)
-	, solver     (new M2::Solver) {}
+	, solver     (new M2::Solver) { solver->setStopFlag(stopFlag); }
 	~CirSolver220() { delete solver; }
 
 	/*====================================*/
 
-	void resetSolverInt() { delete solver; solver = new M2::Solver; }
+	void resetSolverInt() { delete solver; solver = new M2::Solver; solver->setStopFlag(stopFlag); }
+	void removeSatisfied() { solver->simplifyNow(); }
 
 	/*====================================*/
 
@@ -37,6 +43,7 @@ public:
 	void addClause(Lit p, Lit q, Lit r) { solver->addClause(toLit(p), toLit(q), toLit(r)); }
 	void addClause(const vector<Lit>&);
 	void addConflict()                  { solver->addClause(solver->conflict); }
+	void addClauses(const vector<Lit>&, const vector<unsigned>&);
 
 	/*====================================*/
 
@@ -45,7 +52,6 @@ public:
 	/*====================================*/
 
 	lbool getValue(Var v)const { return toLBool(solver->model[v]); }
-	bool inConflict(Var v)const;
 
 	unsigned getVarNum()const { return solver->nVars(); }
 	unsigned getClsNum()const { return solver->nClauses(); }
@@ -54,18 +60,26 @@ public:
 
 	/*====================================*/
 
-	void addAssump(Lit L) { assump.push(toLit(L)); }
-	void clearAssump() { assump.clear(); }
-	bool solve() { return solver->solve(assump); }
+	bool solve() { loadAssump(); clearConflict();
+	               if(solver->solve(assumpVec)) return true;
+	               checkStop(); loadConflict(); return false; }
 
 	void setConfLimit(size_t n) { solver->setConfBudget(n); }
 	void setDeciLimit(size_t n) { /*TODO*/ }
 	void resetLimit()           { solver->budgetOff(); }
-	lbool solveLimited() { return toLBool(solver->solveLimited(assump)); }
+	lbool solveLimited() { loadAssump(); clearConflict();
+	                       const lbool result = toLBool(solver->solveLimited(assumpVec));
+	                       if(result == l_Undef) checkStop();
+	                       else if(result == l_False) loadConflict();
+	                       return result; }
+
+	void loadAssump() { assumpVec.clear(); for(const Lit& L: assump) assumpVec.push(toLit(L)); }
+	void loadConflict();
 
 protected:
 	M2::Solver*       solver;
-	M2::vec<M2::Lit>  assump;
+	M2::vec<M2::Lit>  assumpVec;
+	M2::vec<M2::Lit>  clsTmp;
 };
 
 }
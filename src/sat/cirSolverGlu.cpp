@@ -14,20 +14,30 @@ CirSolver* getSolverGlu(AigNtk* ntk) { return (new CirSolverGlu(ntk)); }
 void
 CirSolverGlu::addClause(const vector<Lit>& litList)
 {
-	G::vec<G::Lit> tmp;
-	tmp.capacity(litList.size());
+	clsTmp.clear();
 	for(const Lit& lit: litList)
-		tmp.push_(toLit(lit));
-	solver->addClause_(tmp);
+		clsTmp.push(toLit(lit));
+	solver->addClause_(clsTmp);
 }
 
-bool
-CirSolverGlu::inConflict(Var v)const
+void
+CirSolverGlu::addClauses(const vector<Lit>& litArr, const vector<unsigned>& lenArr)
+{
+	const Lit* lit = litArr.data();
+	for(unsigned len: lenArr)
+	{
+		clsTmp.clear();
+		for(const Lit* end = lit + len; lit != end; ++lit)
+			clsTmp.push(toLit(*lit));
+		solver->addClause_(clsTmp);
+	}
+}
+
+void
+CirSolverGlu::loadConflict()
 {
 	for(int i = 0; i < solver->conflict.size(); ++i)
-		if(G::var(solver->conflict[i]) == v)
-			return true;
-	return false;
+		markConflict(G::var(solver->conflict[i]));
 }
 
 }
\ No newline at end of file
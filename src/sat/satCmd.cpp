@@ -19,6 +19,15 @@ const string solverName[SOLVER_TYPE_TOTAL] =
 
 SolverType curSolverType = SOLVER_TYPE_GLUCOSE;
 
+const string cnfName[CNF_TYPE_TOTAL] =
+{
+	"Tseitin transformation",
+	"Cut-based encoding",
+	"Polarity-aware encoding"
+};
+
+CnfType curCnfType = CNF_TYPE_TSEITIN;
+
 extern CirSolver* getSolver114(AigNtk*);
 extern CirSolver* getSolver220(AigNtk*);
 extern CirSolver* getSolverGlu(AigNtk*);
@@ -33,6 +42,10 @@ CmdClass(SetSolver, CMD_TYPE_SYSTEM, 4, "-One", 2,
                                         "-Two", 2,
                                         "-GLu", 3,
                                         "-GEt", 3);
+CmdClass(SetCnf, CMD_TYPE_SYSTEM, 4, "-Tseitin",  2,
+                                     "-Cut",      2,
+                                     "-Polarity", 2,
+                                     "-GEt",      3);
 
 struct SatRegistrar : public CmdRegistrar
 {
@@ -40,6 +53,7 @@ struct SatRegistrar : public CmdRegistrar
 	{
 		setFile();
 		setLine(); cmdMgr->regCmd<SetSolverCmd>("SET SOlver", 3, 2);
+		setLine(); cmdMgr->regCmd<SetCnfCmd>("SET CNf", 3, 2);
 	}
 } static satRegistrar;
 
@@ -117,4 +131,73 @@ SetSolverCmd::getHelpStr()const
 	return "Set the type of SAT solver\n";
 }
 
+/*========================================================================
+	SET CNf <-Tseitin | -Cut | -Polarity | -GEt>
+--------------------------------------------------------------------------
+	0: -Tseitin,  2
+	1: -Cut,      2
+	2: -Polarity, 2
+	3: -GEt,      3
+========================================================================*/
+
+CmdExecStatus
+SetCnfCmd::exec(char* options)const
+{
+	enum { TSEITIN = 0, CUT, POLARITY, GET, NONE } type = NONE;
+	for(const char* token: breakToTokens(options))
+		if(optMatch<0>(token))
+		{
+			if(type != NONE)
+				return errorOption(CMD_OPT_EXTRA, token);
+			type = TSEITIN;
+		}
+		else if(optMatch<1>(token))
+		{
+			if(type != NONE)
+				return errorOption(CMD_OPT_EXTRA, token);
+			type = CUT;
+		}
+		else if(optMatch<2>(token))
+		{
+			if(type != NONE)
+				return errorOption(CMD_OPT_EXTRA, token);
+			type = POLARITY;
+		}
+		else if(optMatch<3>(token))
+		{
+			if(type != NONE)
+				return errorOption(CMD_OPT_EXTRA, token);
+			type = GET;
+		}
+		else return errorOption(CMD_OPT_ILLEGAL, token);
+
+	switch(type)
+	{
+		case NONE: return errorOption(CMD_OPT_MISSING);
+		case GET:
+			cout << "Current CNF encoding is " << cnfName[curCnfType] << endl;
+			break;
+
+		default:
+			if(curCnfType == CnfType(type))
+				cout << "The CNF encoding is already " << cnfName[curCnfType] << endl;
+			else
+				cout << "Change CNF encoding to be " << cnfName[curCnfType = CnfType(type)] << endl;
+			break;
+	}
+	return CMD_EXEC_DONE;
+}
+
+const char*
+SetCnfCmd::getUsageStr()const
+{
+	return "<-Tseitin | -Cut | -Polarity | -GEt>\n";
+}
+
+const char*
+SetCnfCmd::getHelpStr()const
+{
+	return "Set the CNF encoding of the circuit for the SAT solvers\n";
+}
+
 }
@@ -13,10 +13,11 @@ namespace _54ff
 {
 
 BmcChecker::BmcChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t timeout,
-	                   size_t maxD, BmcCheckType t)
+	                   size_t maxD, BmcCheckType t, bool groupQ)
 : SafetyNCChecker (ntkToCheck, outputIdx, _trace, timeout)
 , maxDepth        (maxD)
 , type            (t)
+, groupQuery      (groupQ)
 {
 	sfcMsg << "Max depth  : " << maxDepth << endl
 	       << "Method     : Bounded model checking" << endl
@@ -27,25 +28,33 @@ BmcChecker::BmcChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 		case BMC_ONLY_LAST : sfcMsg << "Only the last property is involved"; break;
 	}
 	sfcMsg << endl;
+	if(groupQuery)
+		sfcMsg << "             Check if any output fails before checking them one by one" << endl;
 }
 
 void
 BmcChecker::check()
 {
+	if(allOutput)
+		{ checkMulti(); return; }
 	AigGateV init = buildInit();
 	SolverPtr<CirSolver> solver(ntk);
-	solver->convertToCNF(init.getGateID(), 0);
+	solver->convertToCNF(init.getGateID(), 0, init.isInv());
 	solver->addClause(Lit(solver->getVarInt(init.getGateID(), 0), init.isInv()));
 	for(size_t i = 0; i <= maxDepth; ++i)
 	{
-		cout << "\rTimeFrame = " << i << flush;
-		solver->convertToCNF(property, i);
+		if(checkBreakCond())
+			{ sfcOut << " at depth " << i << endl; return; }
+		sfcOut << "\rTimeFrame = " << i << flush;
+		// The property is asserted to be 0 only under BMC_ASSERT
+		solver->convertPhase(property, i, type == BMC_ASSERT ? CirSolver::PHASE_BOTH : CirSolver::PHASE_POS);
 		solver->clearAssump();
 		solver->addAssump(property, i, false);
 		if(solver->solve())
 		{
-			cout << "\rObserve a counter example at depth " << i << endl;
-			if(trace) solver->reportTrace(i);
+			sfcOut << "\rObserve a counter example at depth " << i << endl;
+			if(trace) solver->reportTrace(sfcOut, i);
+			setResult(SFC_RESULT_SAT);
 			return;
 		}
 		if(type == BMC_ASSERT)
@@ -54,7 +63,84 @@ BmcChecker::check()
 		//The asserted is actually between "p" and tautology
 			solver->addClause(Lit(solver->getVarInt(property, i), true));
 	}
-	cout << "\rNo counter example up to depth " << maxDepth << endl;
+	sfcOut << "\rNo counter example up to depth " << maxDepth << endl;
+}
+
+/*
+	All the outputs share the same unrolling and incremental solver, and each of them is queried by an assumption
+	The falsified outputs are dropped at the depth they fail, and the others go on to the next depth
+	With the grouped query, an activation variable selects the clause that any remaining output fails,
+	and every output failing in its solution is falsified at once
+	Only when it is SAT, the remaining outputs are checked again, so a depth where all outputs hold costs one query
+*/
+void
+BmcChecker::checkMulti()
+{
+	AigGateV init = buildInit();
+	SolverPtr<CirSolver> solver(ntk);
+	solver->convertToCNF(init.getGateID(), 0, init.isInv());
+	solver->addClause(Lit(solver->getVarInt(init.getGateID(), 0), init.isInv()));
+	const size_t O = ntk->getOutputNum();
+	vector<size_t> liveList(O);
+	for(size_t j = 0; j < O; ++j)
+		liveList[j] = j;
+	size_t i = 0;
+	auto falsify = [&](size_t j)
+	{
+		sfcOut << "\rOutput " << j << ": Observe a counter example at depth " << i << endl;
+		if(trace) solver->reportTrace(sfcOut, i);
+	};
+	for(; i <= maxDepth && !liveList.empty(); ++i)
+	{
+		if(checkBreakCond())
+			{ sfcOut << " at depth " << i << endl; break; }
+		sfcOut << "\rTimeFrame = " << i << flush;
+		for(size_t j: liveList)
+			solver->convertPhase(ntk->getOutputID(j), i, type == BMC_ASSERT ? CirSolver::PHASE_BOTH : CirSolver::PHASE_POS);
+		vector<size_t> nextList;
+		if(groupQuery)
+			while(!liveList.empty())
+			{
+				const Var act = solver->newVar();
+				vector<Lit> anyFail(1, Lit(act, true));
+				for(size_t j: liveList)
+					anyFail.push_back(Lit(solver->getVarInt(ntk->getOutputID(j), i), false));
+				solver->addClause(anyFail);
+				solver->clearAssump();
+				solver->addAssump(Lit(act, false));
+				const bool isSat = solver->solve();
+				solver->addClause(Lit(act, true));
+				if(!isSat)
+					break;
+				for(size_t j: liveList)
+					if(solver->getValueBool(ntk->getOutputID(j), i))
+						falsify(j);
+					else nextList.push_back(j);
+				liveList.swap(nextList);
+				nextList.clear();
+			}
+		else
+		{
+			for(size_t j: liveList)
+			{
+				solver->clearAssump();
+				solver->addAssump(ntk->getOutputID(j), i, false);
+				if(solver->solve())
+					falsify(j);
+				else nextList.push_back(j);
+			}
+			liveList.swap(nextList);
+		}
+		if(type == BMC_ASSERT)
+			for(size_t j: liveList)
+				solver->addClause(Lit(solver->getVarInt(ntk->getOutputID(j), i), true));
+	}
+	if(i > maxDepth && !liveList.empty())
+		sfcOut << "\rNo counter example up to depth " << maxDepth << " for " << liveList.size() << " outputs" << endl;
+	sfcOut << "\rFalsified " << O - liveList.size() << ", undetermined " << liveList.size()
+	       << " out of " << O << " outputs" << endl;
+	if(liveList.size() != O)
+		setResult(SFC_RESULT_SAT);
 }
 
 IndChecker::IndChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t timeout,
@@ -88,23 +174,26 @@ IndChecker::check()
 	//this is more efficient, but converting it totally is more convenient
 	//and maybe the inconvenience will introduce extra overhead
 	const Var simpConstraint = solver->newVar(); //reserve for simple constraint
-	cout << "Timeframe = 0," << flush;
+	sfcOut << "Timeframe = 0," << flush;
 	for(size_t i = 0; true;)
 	{
-		cout << " base" << flush;
+		if(checkBreakCond())
+			{ sfcOut << " at depth " << i << endl; return; }
+		sfcOut << " base" << flush;
 		solver->clearAssump();
 		solver->addAssump(init, 0);
 		solver->addAssump(property, i, false);
 		if(solver->solve())
 		{
-			cout << "\rObserve a counter example at depth " << i << endl;
-			if(trace) solver->reportTrace(i);
+			sfcOut << "\rObserve a counter example at depth " << i << endl;
+			if(trace) solver->reportTrace(sfcOut, i);
+			setResult(SFC_RESULT_SAT);
 			return;
 		}
 		if(++i > maxDepth)
-			{ cout << "\rCannot determinie the property up to depth " << maxDepth << endl; return; }
-		cout << CleanStrOnTerminal(" -> base");
-		cout << "\rTimeframe = " << i << ", ind" << flush;
+			{ sfcOut << "\rCannot determinie the property up to depth " << maxDepth << endl; return; }
+		sfcOut << CleanStrOnTerminal(" -> base");
+		sfcOut << "\rTimeframe = " << i << ", ind" << flush;
 		solver->convertToCNF(property, i);
 		for(size_t l = 0; l < L; ++l)
 			solver->convertToCNF(ntk->getLatchID(l), i);
@@ -116,7 +205,7 @@ IndChecker::check()
 		{
 			case IND_SIMPLE_NO:
 				if(!solver->solve())
-					{ cout << "\rProperty proved at depth " << i << endl; return; }
+					{ sfcOut << "\rProperty proved at depth " << i << endl; setResult(SFC_RESULT_UNSAT); return; }
 				break;
 
 			case IND_SIMPLE_NEED:
@@ -124,7 +213,7 @@ IndChecker::check()
 				while(true)
 				{
 					if(!solver->solve())
-						{ cout << "\rProperty proved at depth " << i << endl; return; }
+						{ sfcOut << "\rProperty proved at depth " << i << endl; setResult(SFC_RESULT_UNSAT); return; }
 					for(size_t t1 = 0; t1 < i; ++t1)
 						for(size_t t2 = t1 + 1; t2 <= i; ++t2)
 						{
@@ -174,10 +263,10 @@ IndChecker::check()
 				}
 				solver->addAssump(simpConstraint, false);
 				if(!solver->solve())
-					{ cout << "\rProperty proved at depth " << i << endl; return; }
+					{ sfcOut << "\rProperty proved at depth " << i << endl; setResult(SFC_RESULT_UNSAT); return; }
 			} break;
 		}
-		cout << " ->";
+		sfcOut << " ->";
 	}
 }
 
@@ -186,6 +275,7 @@ ItpChecker::ItpChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 : SafetyNCChecker (ntkToCheck, outputIdx, _trace, timeout)
 , maxDepth        (maxD)
 , type            (t)
+, cutMap          (0)
 {
 	sfcMsg << "Max depth  : " << maxDepth << endl
 	       << "Method     : Interpolation" << endl
@@ -209,15 +299,17 @@ ItpChecker::check()
 	1. Check counter example at timeframe 0
 	*/
 	AigGateV init = buildInit();
+	solver->setCutMap(cutMap = newCutMap(ntk));
 	solver->convertToCNF(init.getGateID(), 0);
 	solver->convertToCNF(property, 0);
 	solver->addAssump(init, 0);
 	solver->addAssump(property, 0, false);
-	cout << "Timeframe = 0" << flush;
+	sfcOut << "Timeframe = 0" << flush;
 	if(solver->solve())
 	{
-		cout << "\rObserve a counter example at depth 0" << endl;
-		if(trace) solver->reportTrace(0);
+		sfcOut << "\rObserve a counter example at depth 0" << endl;
+		if(trace) solver->reportTrace(sfcOut, 0);
+		setResult(SFC_RESULT_SAT);
 		return;
 	}
 
@@ -264,10 +356,12 @@ ItpChecker::check()
 		else target = solver->getVarInt(property, i);
 		AigGateV curReach = init;
 		AigGateV curReachAll = curReach;
-		SolverPtr<CirSolver> eqChecker(ntk);
+		SolverPtr<CirSolver> eqChecker(ntk, cutMap);
 		for(size_t j = 1; true; ++j)
 		{
-			cout << "\rTimeframe = " << i << ", Iteration = " << j << flush;
+			if(checkBreakCond())
+				{ sfcOut << " at depth " << i << endl; return; }
+			sfcOut << "\rTimeframe = " << i << ", Iteration = " << j << flush;
 			solver->clearAssump();
 			solver->addAssump(curReach, 0);
 			solver->addAssump(target, false);
@@ -275,12 +369,13 @@ ItpChecker::check()
 			{
 				if(j == 1)
 				{
-					cout << "\rObserve a counter example at depth " << i << endl;
-					if(trace) solver->reportTrace(i);
+					sfcOut << "\rObserve a counter example at depth " << i << endl;
+					if(trace) solver->reportTrace(sfcOut, i);
+					setResult(SFC_RESULT_SAT);
 					return;
 				}
 				else
-					{ cout << CleanIntOnTerminal(j); break; }
+					{ sfcOut << CleanIntOnTerminal(j); break; }
 			}
 			AigGateV overApprox = solver->buildItp();
 			eqChecker->convertToCNF(curReachAll.getGateID(), 0);
@@ -289,9 +384,9 @@ ItpChecker::check()
 			eqChecker->addAssump(overApprox, 0);
 			bool diff = eqChecker->solve();
 			eqChecker->clearAssump();
-			cout << CleanIntOnTerminal(j);
+			sfcOut << CleanIntOnTerminal(j);
 			if(!diff)
-				{ cout << "\rProperty proved at depth " << i << endl; return; }
+				{ sfcOut << "\rProperty proved at depth " << i << endl; setResult(SFC_RESULT_UNSAT); return; }
 			curReachAll = ntk->createOrConstProp(curReachAll, curReach = overApprox);
 			int c = p.getClsNum(), v = solver->getVarNum();
 			solver->convertToCNF(curReach.getGateID(), 0);
@@ -303,7 +398,7 @@ ItpChecker::check()
 		if(type == ITP_ASSERT)
 			solver->addClause(Lit(solver->getVarInt(property, i), true));
 	}
-	cout << "\rCannot determinie the property up to depth " << maxDepth << endl;
+	sfcOut << "\rCannot determinie the property up to depth " << maxDepth << endl;
 }
 
 }
@@ -8,6 +8,7 @@
 #define HEHE_BMCCHECKER_H
 
 #include "sfcChecker.h"
+#include "cirSolver.h"
 
 namespace _54ff
 {
@@ -21,15 +22,17 @@ enum BmcCheckType
 class BmcChecker : public SafetyNCChecker
 {
 public:
-	BmcChecker(AigNtk*, size_t, bool, size_t, size_t, BmcCheckType);
+	BmcChecker(AigNtk*, size_t, bool, size_t, size_t, BmcCheckType, bool);
 	~BmcChecker() {}
 
 protected:
 	void check();
+	void checkMulti();
 
 protected:
 	size_t        maxDepth;
 	BmcCheckType  type;
+	bool          groupQuery;
 };
 
 enum IndCheckType
@@ -64,7 +67,7 @@ class ItpChecker : public SafetyNCChecker
 {
 public:
 	ItpChecker(AigNtk*, size_t, bool, size_t, size_t, ItpCheckType);
-	~ItpChecker() {}
+	~ItpChecker() { delete cutMap; }
 
 protected:
 	void check();
@@ -72,6 +75,7 @@ protected:
 protected:
 	size_t        maxDepth;
 	ItpCheckType  type;
+	CirCutMap*    cutMap; // shared by the solver and the equivalence checkers
 };
 
 }
@@ -20,47 +20,47 @@ const string pbcStatStr[PBC_STAT_TOTAL] =
 void
 PbcTerSimStat::printStat()const
 {
-	cout << RepeatChar('=', 72) << endl;
+	sfcOut << RepeatChar('=', 72) << endl;
 	if(getNum() == 0)
-		cout << "No ternary simulation!" << endl;
+		sfcOut << "No ternary simulation!" << endl;
 	else
 	{
-		streamsize ss = cout.precision();
-		cout << "Number of ternary simulation   = " << getNum()                     << endl
-		     << fixed << setprecision(3)
-		     << "Average literal count (TerSim) = " << double(getNum(1)) / getNum() << endl
-		     << "Average removal count (TerSim) = " << double(getNum(2)) / getNum() << endl
-		     << "Total runtime on TerSim        = " << getTotalTime() << " s"       << endl
-		     << setprecision(ss)
-		     << "Average runtime on TerSim      = " << getAveTime()   << " s"       << endl;
+		streamsize ss = sfcOut.precision();
+		sfcOut << "Number of ternary simulation   = " << getNum()                     << endl
+		       << fixed << setprecision(3)
+		       << "Average literal count (TerSim) = " << double(getNum(1)) / getNum() << endl
+		       << "Average removal count (TerSim) = " << double(getNum(2)) / getNum() << endl
+		       << "Total runtime on TerSim        = " << getTotalTime() << " s"       << endl
+		       << setprecision(ss)
+		       << "Average runtime on TerSim      = " << getAveTime()   << " s"       << endl;
 	}
 }
 
 void
 PbcSatStat::printStat()const
 {
-	cout << RepeatChar('=', 72) << endl
-	     << "For " << solverName << endl;
+	sfcOut << RepeatChar('=', 72) << endl
+	       << "For " << solverName << endl;
 	if(getNum(0) + getNum(1) == 0)
-		cout << "No SAT query!" << endl;
+		sfcOut << "No SAT query!" << endl;
 	else
 	{
-		streamsize ss = cout.precision();
-		cout << fixed << setprecision(3)
-		     << "  SAT number      = " << getNum(1)                                 << endl
-		     << "  SAT runtime     = " << getTotalTime(1)                   << " s" << endl
-		     << "UNSAT number      = " << getNum(0)                                 << endl
-		     << "UNSAT runtime     = " << getTotalTime(0)                   << " s" << endl
-		     << "Total SAT number  = " << getNum(1) + getNum(0)                     << endl
-		     << "Total SAT runtime = " << getTotalTime(1) + getTotalTime(0) << " s" << endl
-		     << setprecision(ss);
+		streamsize ss = sfcOut.precision();
+		sfcOut << fixed << setprecision(3)
+		       << "  SAT number      = " << getNum(1)                                 << endl
+		       << "  SAT runtime     = " << getTotalTime(1)                   << " s" << endl
+		       << "UNSAT number      = " << getNum(0)                                 << endl
+		       << "UNSAT runtime     = " << getTotalTime(0)                   << " s" << endl
+		       << "Total SAT number  = " << getNum(1) + getNum(0)                     << endl
+		       << "Total SAT runtime = " << getTotalTime(1) + getTotalTime(0) << " s" << endl
+		       << setprecision(ss);
 	}
 }
 
 PbcCube* newPbcCube(const vector<AigGateLit>& litList)
 {
 	const size_t s = litList.size();
-	PbcCube* cube = (PbcCube*)operator new(sizeof(PbcCube) + sizeof(AigGateLit) * s);
+	PbcCube* cube = (PbcCube*)SlabAlloc::allocate(sizeof(PbcCube) + sizeof(AigGateLit) * s);
 	cube->size = s;
 	for(size_t i = 0; i < s; ++i)
 		cube->lit[i] = litList[i];
@@ -69,16 +69,18 @@ PbcCube* newPbcCube(const vector<AigGateLit>& litList)
 
 void delPbcCube(PbcCube* cube)
 {
-	operator delete(cube);
+	SlabAlloc::deallocate(cube, sizeof(PbcCube) + sizeof(AigGateLit) * cube->size);
 }
 
 PbcChecker::PbcChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t timeout, size_t maxF,
                        const Array<bool>& stat, bool _blockState, bool _verbose, const char* reachMethod)
 : SafetyBNChecker (ntkToCheck, outputIdx, _trace, timeout)
 , maxFrame        (maxF)
-, blockSolver     (ntk)
-, inducSolver     (ntk)
-, fixedSolver     (ntk)
+, cutMap          (newCutMap(ntk))
+, cnfTemplate     (ntk, cutMap)
+, blockSolver     (ntk, cutMap)
+, inducSolver     (ntk, cutMap)
+, fixedSolver     (ntk, cutMap)
 , terSimSup       (ntk)
 
 , terSimStat      (stat[PBC_STAT_TERSIM])
@@ -117,10 +119,7 @@ PbcChecker::PbcChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 		blockSolver->convertToCNF(ntk->getLatchID(i), 0);
 
 	// 2. inducSolver: to find notPCube or CTI
-	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
-		inducSolver->convertToCNF(ntk->getLatchID(i), 0);
-	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
-		inducSolver->convertToCNF(ntk->getLatchID(i), 1);
+	inducSolver->loadCNF(cnfTemplate, 0);
 	inducSolver->convertToCNF(property, 0);
 
 	// 3. fixedSolver: to check fixpoint
@@ -159,6 +158,7 @@ PbcChecker::~PbcChecker()
 	for(const vector<PbcCube*>& f: frame)
 		for(PbcCube* c: f)
 			delPbcCube(c);
+	delete cutMap;
 }
 
 void
@@ -169,16 +169,16 @@ PbcChecker::check()
 		while(true)
 		{
 			if(!blockNotPState())
-				{ printCurFrames("F "); cout << "Observe a counter example at frame " << getFrame() << endl; return; }
+				{ printCurFrames("F "); sfcOut << "Observe a counter example at frame " << getFrame() << endl; setResult(SFC_RESULT_SAT); return; }
 			refineAllReach();
 			if(checkFixPoint())
-				{ printCurFrames("F "); cout << "Property proved at frame " << getFrame() << endl; return; }
+				{ printCurFrames("F "); sfcOut << "Property proved at frame " << getFrame() << endl; setResult(SFC_RESULT_UNSAT); return; }
 			if(getFrame() == maxFrame)
-				{ cout << "\rCannot determinie the property up to frame " << maxFrame << endl; return; }
+				{ sfcOut << "\rCannot determinie the property up to frame " << maxFrame << endl; return; }
 			newFrame();
 		}
 	}
-	catch(const CheckerBreak&) { cout << "Cannot determinie the property" << endl; }
+	catch(const CheckerBreak&) { sfcOut << "Cannot determinie the property" << endl; }
 }
 
 bool
@@ -231,9 +231,7 @@ PbcChecker::newFrameFrame()
 void
 PbcChecker::newFrameBlock()
 {
-	const size_t f = getFrame();
-	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
-		blockSolver->convertToCNF(ntk->getLatchID(i), f);
+	blockSolver->loadCNF(cnfTemplate, getFrame() - 1);
 }
 
 void
@@ -428,10 +426,10 @@ PbcChecker::unsatGen(size_t f)const
 void
 PbcChecker::printCurFrames(const char* prefix)const
 {
-	cout << prefix << getFrame() << ": 0";
+	sfcOut << prefix << getFrame() << ": 0";
 	for(size_t i = 1, s = frame.size(); i < s; ++i)
-		cout << " " << frame[i].size();
-	cout << endl;
+		sfcOut << " " << frame[i].size();
+	sfcOut << endl;
 }
 
 void
@@ -439,7 +437,7 @@ PbcChecker::checkBreak(const char* funcName)const
 {
 	if(checkBreakCond())
 	{
-		cout << " during " << funcName << endl;
+		sfcOut << " during " << funcName << endl;
 		printCurFrames("U ");
 		throw CheckerBreak();
 	}
@@ -527,6 +525,7 @@ PbcUChecker::PbcUChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size
 		AigGateV newFanIn = ntk->createAnd(select, l->getFanIn0());
 		l->setFanIn0(newFanIn.getValue());
 	}
+	ntk->invalidateFlatView();
 
 	// 3. fixedSolver
 	fixedActVar.push_back(var_Undef);
@@ -609,8 +608,10 @@ PbcIChecker::PbcIChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size
                        const Array<bool>& stat, bool _verbose)
 : SafetyBNChecker (ntkToCheck, outputIdx, _trace, timeout)
 , maxFrame        (maxF)
-, blkIndSolver    (ntk)
-, fixedSolver     (ntk)
+, cutMap          (newCutMap(ntk))
+, cnfTemplate     (ntk, cutMap)
+, blkIndSolver    (ntk, cutMap)
+, fixedSolver     (ntk, cutMap)
 , terSimSup       (ntk)
 
 , terSimStat      (stat[PBC_STAT_TERSIM])
@@ -691,6 +692,7 @@ PbcIChecker::~PbcIChecker()
 	for(const vector<PbcCube*>& f: frame)
 		for(PbcCube* c: f)
 			delPbcCube(c);
+	delete cutMap;
 }
 
 void
@@ -701,16 +703,16 @@ PbcIChecker::check()
 		while(true)
 		{
 			if(!blockNotPState())
-				{ printCurFrames("F "); cout << "Observe a counter example at frame " << getFrame() << endl; return; }
+				{ printCurFrames("F "); sfcOut << "Observe a counter example at frame " << getFrame() << endl; setResult(SFC_RESULT_SAT); return; }
 			refineAllReach();
 			if(checkFixPoint())
-				{ printCurFrames("F "); cout << "Property proved at frame " << getFrame() << endl; return; }
+				{ printCurFrames("F "); sfcOut << "Property proved at frame " << getFrame() << endl; setResult(SFC_RESULT_UNSAT); return; }
 			if(getFrame() == maxFrame)
-				{ cout << "\rCannot determinie the property up to frame " << maxFrame << endl; return; }
+				{ sfcOut << "\rCannot determinie the property up to frame " << maxFrame << endl; return; }
 			newFrame();
 		}
 	}
-	catch(const CheckerBreak&) { cout << "Cannot determinie the property" << endl; }
+	catch(const CheckerBreak&) { sfcOut << "Cannot determinie the property" << endl; }
 }
 
 bool
@@ -781,9 +783,7 @@ PbcIChecker::newFrameFrame()
 void
 PbcIChecker::newFrameBlock()
 {
-	const size_t f = getFrame();
-	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
-		blkIndSolver->convertToCNF(ntk->getLatchID(i), f);
+	blkIndSolver->loadCNF(cnfTemplate, getFrame() - 1);
 }
 
 void
@@ -1007,10 +1007,10 @@ PbcIChecker::unsatGen(size_t f)const
 void
 PbcIChecker::printCurFrames(const char* prefix)const
 {
-	cout << prefix << getFrame() << ": 0";
+	sfcOut << prefix << getFrame() << ": 0";
 	for(size_t i = 1, s = frame.size(); i < s; ++i)
-		cout << " " << frame[i].size();
-	cout << endl;
+		sfcOut << " " << frame[i].size();
+	sfcOut << endl;
 }
 
 void
@@ -1018,7 +1018,7 @@ PbcIChecker::checkBreak(const char* funcName)const
 {
 	if(checkBreakCond())
 	{
-		cout << " during " << funcName << endl;
+		sfcOut << " during " << funcName << endl;
 		printCurFrames("U ");
 		throw CheckerBreak();
 	}
@@ -12,6 +12,7 @@
 #include "cirSolver.h"
 #include "aigMisc1.h"
 #include "stat.h"
+#include "slabAlloc.h"
 
 namespace _54ff
 {
@@ -126,6 +127,8 @@ protected:
 	size_t  maxFrame;
 
 	vector<vector<PbcCube*>>  frame;
+	CirCutMap*                cutMap;
+	CirCnfTemplate            cnfTemplate;
 	SolverPtr<CirSolver>      blockSolver;
 	SolverPtr<CirSolver>      inducSolver;
 	vector<Var>               inducActVar;
@@ -227,6 +230,8 @@ protected:
 	size_t  maxFrame;
 
 	vector<vector<PbcCube*>>  frame;
+	CirCutMap*                cutMap;
+	CirCnfTemplate            cnfTemplate;
 	SolverPtr<CirSolver>      blkIndSolver;
 	vector<Var>               inducActVar;
 	SolverPtr<CirSolver>      fixedSolver;
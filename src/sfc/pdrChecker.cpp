@@ -4,8 +4,13 @@
 |: [Synopsis] Implement the PDR checker                                  :|
 <------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <queue>
 #include <sstream>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 #include "pdrChecker.h"
 #include "condStream.h"
 #include "alg.h"
@@ -41,150 +46,187 @@ const string pdrVerboseStr[PDR_VERBOSE_TOTAL] =
 };
 
 void
-PdrTerSimStat::printStat()const
+PdrTerSimStat::printStat(bool lift)const
 {
-	cout << RepeatChar('=', 72) << endl;
+	sfcOut << RepeatChar('=', 72) << endl;
 	if(getNum() == 0)
-		cout << "No ternary simulation!" << endl;
+		sfcOut << (lift ? "No lifting!" : "No ternary simulation!") << endl;
+	else if(lift)
+	{
+		streamsize ss = sfcOut.precision();
+		sfcOut << "Number of lifting              = " << getNum()                     << endl
+		       << fixed << setprecision(3)
+		       << "Average literal count (Lift)   = " << double(getNum(1)) / getNum() << endl
+		       << "Average removal count (Lift)   = " << double(getNum(2)) / getNum() << endl
+		       << "Total runtime on Lift          = " << getTotalTime() << " s"       << endl
+		       << setprecision(ss)
+		       << "Average runtime on Lift        = " << getAveTime()   << " s"       << endl;
+	}
 	else
 	{
-		streamsize ss = cout.precision();
-		cout << "Number of ternary simulation   = " << getNum()                     << endl
-		     << fixed << setprecision(3)
-		     << "Average literal count (TerSim) = " << double(getNum(1)) / getNum() << endl
-		     << "Average removal count (TerSim) = " << double(getNum(2)) / getNum() << endl
-		     << "Total runtime on TerSim        = " << getTotalTime() << " s"       << endl
-		     << setprecision(ss)
-		     << "Average runtime on TerSim      = " << getAveTime()   << " s"       << endl;
+		streamsize ss = sfcOut.precision();
+		sfcOut << "Number of ternary simulation   = " << getNum()                     << endl
+		       << fixed << setprecision(3)
+		       << "Average literal count (TerSim) = " << double(getNum(1)) / getNum() << endl
+		       << "Average removal count (TerSim) = " << double(getNum(2)) / getNum() << endl
+		       << "Total runtime on TerSim        = " << getTotalTime() << " s"       << endl
+		       << setprecision(ss)
+		       << "Average runtime on TerSim      = " << getAveTime()   << " s"       << endl;
 	}
 }
 
 void
-PdrSatStat::printStat(bool useApprox)const
+PdrSatStat::printStat(bool useApprox, bool useFilter)const
 {
-	cout << RepeatChar('=', 72) << endl;
+	sfcOut << RepeatChar('=', 72) << endl;
 	if(getNum(0) + getNum(1) + getNum(2) == 0)
-		cout << "No SAT query!" << endl;
+		sfcOut << "No SAT query!" << endl;
 	else
 	{
-		cout << "The approximate SAT query is " << (useApprox ? "" : "not ") << "activated!" << endl;
-		streamsize ss = cout.precision();
-		cout << fixed << setprecision(3)
-		     << "  SAT number      = " << getNum(1)                                 << endl
-		     << "  SAT runtime     = " << getTotalTime(1)                   << " s" << endl
-		     << "UNSAT number      = " << getNum(0)                                 << endl
-		     << "UNSAT runtime     = " << getTotalTime(0)                   << " s" << endl
-		     << "Abort number      = " << getNum(2)                                 << endl
-		     << "Abort runtime     = " << getTotalTime(2)                   << " s" << endl
-		     << "Total number      = " << getNum(1) + getNum(0) + getNum(2)         << endl
-		     << "Total runtime     = " << getTotalTime(1) +
+		sfcOut << "The approximate SAT query is " << (useApprox ? "" : "not ") << "activated!" << endl;
+		streamsize ss = sfcOut.precision();
+		sfcOut << fixed << setprecision(3)
+		       << "  SAT number      = " << getNum(1)                                 << endl
+		       << "  SAT runtime     = " << getTotalTime(1)                   << " s" << endl
+		       << "UNSAT number      = " << getNum(0)                                 << endl
+		       << "UNSAT runtime     = " << getTotalTime(0)                   << " s" << endl
+		       << "Abort number      = " << getNum(2)                                 << endl
+		       << "Abort runtime     = " << getTotalTime(2)                   << " s" << endl
+		       << "Total number      = " << getNum(1) + getNum(0) + getNum(2)         << endl
+		       << "Total runtime     = " << getTotalTime(1) +
 		                                  getTotalTime(0) +
 		                                  getTotalTime(2)                   << " s" << endl
 		     << "Last solving time = " << getTotalTime(3)                   << " s" << endl;
-		cout << "Min   SAT decision = "; if(getNum(1) != 0) cout << minSAT_D;   else cout << "None"; cout << endl;
-		cout << "Max UNSAT decision = "; if(getNum(0) != 0) cout << maxUNSAT_D; else cout << "None"; cout << endl;
-		cout << "Max Abort decision = "; if(getNum(2) != 0) cout << maxAbort_D; else cout << "None"; cout << endl;
-		cout << "Average number of decision per query = " << double(getNum(3)) / (getNum(1) + getNum(0) + getNum(2)) << endl
-		     << "Average number of conflict per query = " << double(getNum(4)) / (getNum(1) + getNum(0) + getNum(2)) << endl
-		     << setprecision(ss);
+		sfcOut << "Min   SAT decision = "; if(getNum(1) != 0) sfcOut << minSAT_D;   else sfcOut << "None"; sfcOut << endl;
+		sfcOut << "Max UNSAT decision = "; if(getNum(0) != 0) sfcOut << maxUNSAT_D; else sfcOut << "None"; sfcOut << endl;
+		sfcOut << "Max Abort decision = "; if(getNum(2) != 0) sfcOut << maxAbort_D; else sfcOut << "None"; sfcOut << endl;
+		sfcOut << "Average number of decision per query = " << double(getNum(3)) / (getNum(1) + getNum(0) + getNum(2)) << endl
+		       << "Average number of conflict per query = " << double(getNum(4)) / (getNum(1) + getNum(0) + getNum(2)) << endl
+		       << setprecision(ss);
+	}
+	if(useFilter)
+	{
+		streamsize ss = sfcOut.precision();
+		sfcOut << fixed << setprecision(3)
+		       << "Filtered query number  = " << getNum(5)                         << endl
+		       << "Filtered SAT number    = " << getNum(6)                         << endl
+		       << "Filter hit rate        = " << (getNum(5) == 0 ? 0.0 : 100.0 * getNum(6) / getNum(5)) << " %" << endl
+		       << "Filter runtime         = " << getTotalTime(4)           << " s" << endl
+		       << setprecision(ss);
 	}
 }
 
 void
-PdrUnsatGenStat::printStat()const
+PdrUnsatGenStat::printStat(bool ctg)const
 {
-	cout << RepeatChar('=', 72) << endl;
+	sfcOut << RepeatChar('=', 72) << endl;
 	if(getNum() == 0)
-		cout << "No UNSAT generalization!" << endl;
+		sfcOut << "No UNSAT generalization!" << endl;
 	else
 	{
-		streamsize ss = cout.precision();
-		cout << fixed << setprecision(3)
-		     << "Number of UNSAT generalization   = " << getNum()                                  << endl
-		     << "Runtime on remove stage          = " << getTotalTime(0)                   << " s" << endl
-		     << "Runtime on push stage            = " << getTotalTime(1)                   << " s" << endl
-		     << "Runtime on UNSAT Gen             = " << getTotalTime(0) + getTotalTime(1) << " s" << endl
-		     << "Average remove count (UNSAT Gen) = " << double(getNum(1)) / getNum()              << endl
-		     << setprecision(ss);
+		streamsize ss = sfcOut.precision();
+		sfcOut << fixed << setprecision(3)
+		       << "Number of UNSAT generalization   = " << getNum()                                  << endl
+		       << "Runtime on remove stage          = " << getTotalTime(0)                   << " s" << endl
+		       << "Runtime on push stage            = " << getTotalTime(1)                   << " s" << endl
+		       << "Runtime on UNSAT Gen             = " << getTotalTime(0) + getTotalTime(1) << " s" << endl
+		       << "Average remove count (UNSAT Gen) = " << double(getNum(1)) / getNum()              << endl;
+		if(ctg)
+			sfcOut << "Number of CTG found              = " << getNum(2) << endl
+			       << "Number of CTG blocked            = " << getNum(3) << endl
+			       << "Remove count after blocking CTG  = " << getNum(4) << endl
+			       << "Average remove count (CTG)       = " << (getNum(3) == 0 ? 0.0 : double(getNum(4)) / getNum(3)) << endl;
+		sfcOut << setprecision(ss);
 	}
 }
 
 void
 PdrPropStat::printStat()const
 {
-	cout << RepeatChar('=', 72) << endl;
+	sfcOut << RepeatChar('=', 72) << endl;
 	if(getNum() == 0)
-		cout << "No cube propagation!" << endl;
+		sfcOut << "No cube propagation!" << endl;
 	else
 	{
-		streamsize ss = cout.precision();
-		cout << fixed << setprecision(3)
-		     << "Number of cube propagation  = " << getNum()               << endl
-		     << "Runtime on cube propagation = " << getTotalTime() << " s" << endl
-		     << "Number of cubes tried to be propagated            = " << getNum(1) << endl
-		     << "Number of cubes propagated to further frame       = " << getNum(2) << endl
-		     << "Number of cubes added to Inf by eager propagation = " << getNum(3) << endl
-		     << "Number of literals removed in Inf                 = " << getNum(4) << endl
-		     << setprecision(ss);
+		streamsize ss = sfcOut.precision();
+		sfcOut << fixed << setprecision(3)
+		       << "Number of cube propagation  = " << getNum()               << endl
+		       << "Runtime on cube propagation = " << getTotalTime() << " s" << endl
+		       << "Number of cubes tried to be propagated            = " << getNum(1) << endl
+		       << "Number of cubes propagated to further frame       = " << getNum(2) << endl
+		       << "Number of cubes added to Inf by eager propagation = " << getNum(3) << endl
+		       << "Number of literals removed in Inf                 = " << getNum(4) << endl
+		       << setprecision(ss);
 	}
 }
 
 void
 PdrRecycleStat::printStat()const
 {
-	cout << RepeatChar('=', 72) << endl;
+	sfcOut << RepeatChar('=', 72) << endl;
 	if(getNum() == 0)
-		cout << "No solver recycling!" << endl;
+		sfcOut << "No solver recycling!" << endl;
 	else
 	{
-		streamsize ss = cout.precision();
-		cout << fixed << setprecision(3)
-		     << "Number of solver recycling  = " << getNum()               << endl
-		     << "Max number at recycling     = " << maxRecNum              << endl
-		     << "Runtime on solver recycling = " << getTotalTime() << " s" << endl
-		     << setprecision(ss);
+		streamsize ss = sfcOut.precision();
+		sfcOut << fixed << setprecision(3)
+		       << "Number of solver recycling  = " << getNum()               << endl
+		       << "Max number at recycling     = " << maxRecNum              << endl
+		       << "Number of removed clauses   = " << getNum(1)              << endl
+		       << "Runtime on solver recycling = " << getTotalTime() << " s" << endl
+		       << setprecision(ss);
 	}
 }
 
 void
 PdrCubeStat::printStat()const
 {
-	streamsize ss = cout.precision();
-	cout << RepeatChar('=', 72) << endl
-	     << fixed << setprecision(3)
-	     << "Number of subsumption checking  = " << getNum()                               << endl
-	     << "Runtime on subsumption checking = " << getTotalTime() << " s (Approximation)" << endl
-	     << "     Subsumption when adding proof obligation   = " << getNum(1)   << endl
-	     << "Self subsumption when adding proof obligation   = " << getNum(2)   << endl
-	     << "     Subsumption when blocking proof obligation = " << getNum(3)   << endl
-	     << "     Subsumption when adding blocked cube       = " << getNum(4)   << endl
-	     << "Self subsumption when adding blocked cube       = " << getNum(5)   << endl
-	     << "Max number of proof obligation in one timeframe = " << maxBadNum   << endl
-	     << "Max number of proof tree in one recBlockCube    = " << maxTreeSize << endl
-	     << setprecision(1)
-	     << "Total number of cubes added to frame Inf   = " << getNum(7)                     << endl;
-	cout << "Average length of cubes added to frame Inf = ";
-	if(getNum(7) != 0) cout << double(getNum(6)) / getNum(7); else cout << "None";      cout << endl;
-	cout << "Maximum length of cubes added to frame Inf = ";
-	if(getNum(7) != 0) cout << maxInfClsLen;                  else cout << "None";      cout << endl;
-	cout << setprecision(ss);
+	streamsize ss = sfcOut.precision();
+	sfcOut << RepeatChar('=', 72) << endl
+	       << fixed << setprecision(3)
+	       << "Number of subsumption checking  = " << getNum()                               << endl
+	       << "Runtime on subsumption checking = " << getTotalTime() << " s (Approximation)" << endl
+	       << "     Subsumption when adding proof obligation   = " << getNum(1)   << endl
+	       << "Self subsumption when adding proof obligation   = " << getNum(2)   << endl
+	       << "     Subsumption when blocking proof obligation = " << getNum(3)   << endl
+	       << "     Subsumption when adding blocked cube       = " << getNum(4)   << endl
+	       << "Self subsumption when adding blocked cube       = " << getNum(5)   << endl
+	       << "Max number of proof obligation in one timeframe = " << maxBadNum   << endl
+	       << "Max number of proof tree in one recBlockCube    = " << maxTreeSize << endl
+	       << setprecision(1)
+	       << "Total number of cubes added to frame Inf   = " << getNum(7)                     << endl;
+	sfcOut << "Average length of cubes added to frame Inf = ";
+	if(getNum(7) != 0) sfcOut << double(getNum(6)) / getNum(7); else sfcOut << "None";      sfcOut << endl;
+	sfcOut << "Maximum length of cubes added to frame Inf = ";
+	if(getNum(7) != 0) sfcOut << maxInfClsLen;                  else sfcOut << "None";      sfcOut << endl;
+	sfcOut << "Cubes in the searched frames for subsumption = " << getNum(8) << endl
+	       << "Candidates left by the occurrence index      = " << getNum(9) << endl
+	       << "Pruning ratio of the occurrence index        = ";
+	if(getNum(8) != 0) sfcOut << 100.0 * (getNum(8) - getNum(9)) / getNum(8) << " %"; else sfcOut << "None"; sfcOut << endl;
+	sfcOut << "Proof obligations to push             = " << getNum(10) << endl
+	       << "Duplicate proof obligations rejected  = " << getNum(11) << endl
+	       << "Hit rate of the obligation table      = ";
+	if(getNum(10) != 0) sfcOut << 100.0 * getNum(11) / getNum(10) << " %"; else sfcOut << "None"; sfcOut << endl;
+	sfcOut << "Peak memory of cubes = " << SlabAlloc::getPeakBytes() << " bytes" << endl
+	       << "Live memory of cubes = " << SlabAlloc::getLiveBytes() << " bytes" << endl;
+	sfcOut << setprecision(ss);
 }
 
 void
 PdrStimuStat::printStat()const
 {
-	cout << RepeatChar('=', 72) << endl;
+	sfcOut << RepeatChar('=', 72) << endl;
 	if(getNum(0) + getNum(1) + getNum(2) == 0)
-		cout << "No stimulation!" << endl;
+		sfcOut << "No stimulation!" << endl;
 	else
 	{
-		streamsize ss = cout.precision();
-		cout << fixed << setprecision(3)
-		     << "Runtime on stimulation = " << getTotalTime() << " s" << endl
-		     << "#PASS = " << getNum(0) << ", #FAIL = " << getNum(1) << ", #ABORT = " << getNum(2)
-		     << ", #Total = " << getNum(0) + getNum(1) + getNum(2) << endl
-		     << "Number of clauses added to frame Inf = " << getNum(3) << endl
-		     << setprecision(ss);
+		streamsize ss = sfcOut.precision();
+		sfcOut << fixed << setprecision(3)
+		       << "Runtime on stimulation = " << getTotalTime() << " s" << endl
+		       << "#PASS = " << getNum(0) << ", #FAIL = " << getNum(1) << ", #ABORT = " << getNum(2)
+		       << ", #Total = " << getNum(0) + getNum(1) + getNum(2) << endl
+		       << "Number of clauses added to frame Inf = " << getNum(3) << endl
+		       << setprecision(ss);
 	}
 }
 
@@ -220,6 +262,27 @@ PdrCube::PdrCube(const vector<AigGateLit>& litList, bool toSort, const PdrCube*
 	setBadDepth(prevCube == 0 ? 0 : prevCube->getBadDepth() + 1);
 }
 
+void
+PdrCube::clear()
+{
+	// Release the trace in a loop rather than through the destructor of prevCube,
+	// otherwise a long trace overflows the stack
+	PdrCube cur; cur.uint32Ptr = uint32Ptr;
+	while(true)
+	{
+		PdrCube& prev = cur.getPrevCube();
+		unsigned* prevPtr = prev.uint32Ptr;
+		prev.uint32Ptr = 0;
+		cur.freeMem();
+		if((cur.uint32Ptr = prevPtr) == 0)
+			break;
+		cur.decCount();
+		if(!cur.toDelete())
+			break;
+	}
+	cur.uint32Ptr = 0;
+}
+
 bool
 PdrCube::operator<(const PdrCube& c)const
 {
@@ -234,6 +297,15 @@ PdrCube::operator<(const PdrCube& c)const
 	return getSize() < c.getSize();
 }
 
+size_t
+PdrCube::getHash()const
+{
+	size_t h = getAbs() ^ getSize();
+	for(unsigned i = 0; i < getSize(); ++i)
+		h = (h ^ getLit(i)) * 0x100000001b3;
+	return h;
+}
+
 bool
 PdrCube::operator==(const PdrCube& c)const
 {
@@ -356,6 +428,185 @@ PdrCube::selfSubsumeComplex(const PdrCube& c)const
 	return ret;
 }
 
+/*
+	The vectorized versions of subsumeComplexN and selfSubsumeComplex
+	Both cubes are sorted, so for each literal of the smaller cube we only need the first position
+	of the larger cube whose literal is not less than a given key, and the position never goes back
+	The position is found by comparing the key with 8 (AVX2) or 4 (SSE2) literals at once
+	and counting the smaller ones, the scalar loop handles the tail
+	The literals are biased by 2^31 since there is no unsigned comparison for packed integers
+	The kernel is selected by the features of the CPU at startup
+*/
+
+static inline unsigned skipLessScalar(const AigGateLit* lit, unsigned j, unsigned n, AigGateLit key)
+{
+	while(j < n && lit[j] < key) ++j;
+	return j;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+static inline unsigned skipLessSse2(const AigGateLit* lit, unsigned j, unsigned n, AigGateLit key)
+{
+	const __m128i bias = _mm_set1_epi32(int(0x80000000u));
+	const __m128i k = _mm_set1_epi32(int(key ^ 0x80000000u));
+	for(; j + 4 <= n; j += 4)
+	{
+		const __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(lit + j)), bias);
+		const int less = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(k, v)));
+		if(less != 0xF)
+			return j + __builtin_popcount(less);
+	}
+	return skipLessScalar(lit, j, n, key);
+}
+
+__attribute__((target("avx2")))
+static inline unsigned skipLessAvx2(const AigGateLit* lit, unsigned j, unsigned n, AigGateLit key)
+{
+	const __m256i bias = _mm256_set1_epi32(int(0x80000000u));
+	const __m256i k = _mm256_set1_epi32(int(key ^ 0x80000000u));
+	for(; j + 8 <= n; j += 8)
+	{
+		const __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(lit + j)), bias);
+		const int less = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, v)));
+		if(less != 0xFF)
+			return j + __builtin_popcount(less);
+	}
+	return skipLessScalar(lit, j, n, key);
+}
+#endif
+
+// Always inlined into the kernel of each instruction set, so that the skipping function is inlined as well
+using SkipFunc = unsigned (*)(const AigGateLit*, unsigned, unsigned, AigGateLit);
+
+template <SkipFunc skipLess>
+__attribute__((always_inline))
+static inline bool subsumeKernel(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+{
+	for(unsigned i = 0, j = 0; i < m; ++i, ++j)
+	{
+		// The remaining literals cannot be matched
+		if(n - j < m - i)
+			return false;
+		j = skipLess(c, j, n, a[i]);
+		if(j == n || c[j] != a[i])
+			return false;
+	}
+	return true;
+}
+
+template <SkipFunc skipLess>
+__attribute__((always_inline))
+static inline AigGateLit selfSubsumeKernel(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+{
+	AigGateLit ret = UNDEF_GATELIT;
+	for(unsigned i = 0, j = 0; i < m; ++i, ++j)
+	{
+		if(n - j < m - i)
+			return ERROR_GATELIT;
+		// Skip the literals of smaller gate IDs
+		j = skipLess(c, j, n, a[i] & ~AigGateLit(1));
+		if(j == n)
+			return ERROR_GATELIT;
+		if(c[j] == a[i])
+			continue;
+		if(getGateID(c[j]) != getGateID(a[i]) || ret != UNDEF_GATELIT)
+			return ERROR_GATELIT;
+		ret = c[j];
+	}
+	return ret;
+}
+
+using SubsumeFunc     = bool       (*)(const AigGateLit*, unsigned, const AigGateLit*, unsigned);
+using SelfSubsumeFunc = AigGateLit (*)(const AigGateLit*, unsigned, const AigGateLit*, unsigned);
+
+static bool subsumeScalar(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+	{ return subsumeKernel<skipLessScalar>(a, m, c, n); }
+static AigGateLit selfSubsumeScalar(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+	{ return selfSubsumeKernel<skipLessScalar>(a, m, c, n); }
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+static bool subsumeSse2(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+	{ return subsumeKernel<skipLessSse2>(a, m, c, n); }
+__attribute__((target("sse2")))
+static AigGateLit selfSubsumeSse2(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+	{ return selfSubsumeKernel<skipLessSse2>(a, m, c, n); }
+__attribute__((target("avx2")))
+static bool subsumeAvx2(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+	{ return subsumeKernel<skipLessAvx2>(a, m, c, n); }
+__attribute__((target("avx2")))
+static AigGateLit selfSubsumeAvx2(const AigGateLit* a, unsigned m, const AigGateLit* c, unsigned n)
+	{ return selfSubsumeKernel<skipLessAvx2>(a, m, c, n); }
+#endif
+
+struct SubsumeDispatcher
+{
+	SubsumeDispatcher()
+	{
+	#if defined(__x86_64__) || defined(__i386__)
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2"))
+			{ name = "AVX2"; subsume = subsumeAvx2; selfSubsume = selfSubsumeAvx2; return; }
+		if(__builtin_cpu_supports("sse2"))
+			{ name = "SSE2"; subsume = subsumeSse2; selfSubsume = selfSubsumeSse2; return; }
+	#endif
+		name = "Scalar"; subsume = subsumeScalar; selfSubsume = selfSubsumeScalar;
+	}
+
+	const char*      name;
+	SubsumeFunc      subsume;
+	SelfSubsumeFunc  selfSubsume;
+} static const subsumeDispatcher;
+
+// Short cubes are not worth the indirect call
+static constexpr unsigned vecMinSize = 16;
+
+const char*
+PdrCube::getSubsumeKernelStr()
+{
+	return subsumeDispatcher.name;
+}
+
+bool
+PdrCube::subsumeComplexV(const PdrCube& c)const
+{
+	if(c.getSize() < vecMinSize)
+		return subsumeComplexN(c);
+	if((getAbs() & ~c.getAbs()) != 0 ||
+	   getSize() > c.getSize())
+		return false;
+	return subsumeDispatcher.subsume(begin(), getSize(), c.begin(), c.getSize());
+}
+
+AigGateLit
+PdrCube::selfSubsumeComplexV(const PdrCube& c)const
+{
+	if(c.getSize() < vecMinSize)
+		return selfSubsumeComplex(c);
+	if((getAbs() & ~c.getAbs()) != 0 ||
+	   getSize() > c.getSize())
+		return ERROR_GATELIT;
+	return subsumeDispatcher.selfSubsume(begin(), getSize(), c.begin(), c.getSize());
+}
+
+void
+PdrSharedStore::publish(size_t owner, size_t f, const PdrCube& c)
+{
+	lock_guard<mutex> lock(cubeLock);
+	cubeList.push_back({ owner, f, vector<AigGateLit>(c.begin(), c.end()) });
+	cubeNum.store(cubeList.size(), memory_order_release);
+}
+
+void
+PdrSharedStore::fetch(size_t reader, size_t& readNum, vector<pair<size_t, vector<AigGateLit>>>& newCubes)const
+{
+	lock_guard<mutex> lock(cubeLock);
+	for(size_t n = cubeList.size(); readNum < n; ++readNum)
+		if(const SharedCube& sc = cubeList[readNum]; sc.owner != reader)
+			newCubes.emplace_back(sc.frame, sc.litList);
+}
+
 PdrChecker* getDefaultPdr(AigNtk* ntk)
 {
 	constexpr size_t fakeOutputIdx = 0;
@@ -367,6 +618,8 @@ PdrChecker* getDefaultPdr(AigNtk* ntk)
 	constexpr size_t noOblLimit    = 0;
 	constexpr size_t vbsOff        = 0;
 	constexpr bool   noCheckII     = false;
+	constexpr size_t singleThread  = 1;
+	constexpr size_t singlePropTh  = 1;
 
 	constexpr PdrClsStimuType noClsStimu = PDR_CLS_STIMU_NONE;
 	constexpr PdrOblStimuType noOblStimu = PDR_OBL_STIMU_NONE;
@@ -386,25 +639,27 @@ PdrChecker* getDefaultPdr(AigNtk* ntk)
 	constexpr bool       checkSelf          = false;
 	constexpr bool       assertFrame        = false;
 	constexpr bool       recycleByQuery     = true;
+	constexpr bool       recycleIncr        = false;
 	constexpr bool       lazyProp           = true;
 	constexpr bool       sortByBadDepth     = false;
+	constexpr bool       perFrameSolver     = false;
 
 	return (new PdrChecker(ntk, fakeOutputIdx, noTrace, noTimeout, noMaxFrame, recycleNum, noStat,
 	                       simType, ordType, oblType, deqType, prpType, genType,
-	                       toRefineInf, convertInNeedCone, checkSelf, assertFrame, recycleByQuery, convertInNeedFrame, lazyProp, sortByBadDepth,
-	                       noSatLimit, noOblLimit, vbsOff, noCheckII,
+	                       toRefineInf, convertInNeedCone, checkSelf, assertFrame, recycleByQuery, recycleIncr, convertInNeedFrame, lazyProp, sortByBadDepth, perFrameSolver,
+	                       noSatLimit, noOblLimit, vbsOff, noCheckII, singleThread, singlePropTh, dummy, dummy, dummy,
 	                       noClsStimu, noShare, dummy, dummy, dummy,
 	                       noOblStimu, noShare, dummy, dummy));
 }
 
 PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t timeout, size_t maxF, size_t recycleN, size_t stats,
                        PdrSimType simT, PdrOrdType ordT, PdrOblType oblT, PdrDeqType deqT, PdrPrpType prpT, PdrGenType genT,
-                       bool rInf, bool cInNeedC, bool cSelf, bool assertF, bool recycleBQ, bool cInNeedF, bool lazyP, bool sortByBD,
-                       size_t satQL, size_t oblL, size_t _verbosity, bool checkII,
+                       bool rInf, bool cInNeedC, bool cSelf, bool assertF, bool recycleBQ, bool recycleInc, bool cInNeedF, bool lazyP, bool sortByBD, bool perFrameS,
+                       size_t satQL, size_t oblL, size_t _verbosity, bool checkII, size_t threadN, size_t propThreadN, size_t ctgN, size_t ctgD, size_t patBlockN,
                        PdrClsStimuType clsStimuT, PdrShareType clsShareT, size_t clsStimuNum1, size_t clsStimuNum2, size_t clsStimuNum3,
                        PdrOblStimuType oblStimuT, PdrShareType oblShareT, size_t oblStimuNum1, size_t oblStimuNum2)
 : SafetyBNChecker    (ntkToCheck, outputIdx, _trace, timeout)
-, mainType           (PDR_MAIN_NORMAL)
+, mainType           (allOutput ? PDR_MAIN_MULTI : PDR_MAIN_NORMAL)
 , initType           (PDR_INIT_DEFAULT)
 , curFrame           (0)
 , maxFrame           (maxF)
@@ -418,9 +673,13 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 , unusedVarNum       (0)
 , recycleNum         (recycleN)
 , maxUNSAT_D         (0)
-, solver             (ntk)
+, cutMap             (newCutMap(ntk))
+, mainSolver         (ntk, cutMap)
+, solver             (mainSolver)
+, cnfTemplate        (0)
 , terSimSup          (ntk)
 , actInc             (1.0)
+, actBumpNum         (0)
 
 , terSimStat         (isPdrStatON(stats, PDR_STAT_TERSIM))
 , satStat            (isPdrStatON(stats, PDR_STAT_SAT))
@@ -437,12 +696,14 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 , genType            (genT)
 , toRefineInf        (rInf)
 , convertInNeedCone  (cInNeedC)
-, convertInNeedFrame (cInNeedF)
+, convertInNeedFrame (cInNeedF || perFrameS)
 , checkSelf          (cSelf)
 , assertFrame        (assertF)
 , recycleByQuery     (recycleBQ)
+, recycleIncr        (recycleInc)
 , lazyProp           (lazyP)
 , sortByBadDepth     (sortByBD)
+, perFrameSolver     (perFrameS)
 , checkIndInv        (checkII)
 
 , frameConverted     (0)
@@ -453,6 +714,21 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 , numObl             (0)
 , numOblLimit        (oblL)
 , verbosity          (_verbosity | getPdrVbsMask(PDR_VERBOSE_FRAME))
+, threadNum          (threadN == 0 ? 1 : threadN)
+, threadIdx          (0)
+, sharedStore        (0)
+, sharedReadNum      (0)
+, propThreadNum      (propThreadN == 0 ? 1 : propThreadN)
+, curSolverIdx       (0)
+, liftSolver         (0)
+, ctgNumLimit        (ctgN)
+, ctgDepthLimit      (ctgD)
+, ctgDepth           (0)
+, patBlockNum        (patBlockN)
+, patBlock           (0)
+, patIdx             (64)
+, patHit             (MAX_SIZE_T)
+, simMask            (0)
 {
 	sfcMsg << "Max Frame  : " << maxFrame << endl
 	       << "Method     : Property directed reachability" << endl
@@ -465,6 +741,7 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 	sfcMsg << endl;
 	sfcMsg << "             Number of " << (recycleByQuery ? "SAT query times" : "unused variable") << " to recycle the solver = ";
 	if(recycleNum == 0) sfcMsg << "Infinity"; else sfcMsg << recycleNum;
+	if(recycleNum != 0 && recycleIncr) sfcMsg << " (by removing the retired clauses)";
 	sfcMsg << endl;
 	sfcMsg << "             ";
 	switch(simType)
@@ -473,6 +750,7 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 		case PDR_SIM_FORWARD_EVENT     : sfcMsg << "Forward ternary simulation, Event-driven mode";        break;
 		case PDR_SIM_BACKWARD_NORMAL   : sfcMsg << "BackWard SAT generalization, Only latch variable";     break;
 		case PDR_SIM_BACKWARD_INTERNAL : sfcMsg << "BackWard SAT generalization, Involve internal signal"; break;
+		case PDR_SIM_LIFT              : sfcMsg << "SAT lifting by a dedicated solver";                    break;
 	}
 	sfcMsg << endl;
 	sfcMsg << "             ";
@@ -498,6 +776,9 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 	{
 		case PDR_DEQ_STACK : sfcMsg << "Apply stack-like behavior when getting bad cubes"; break;
 		case PDR_DEQ_QUEUE : sfcMsg << "Apply queue-like behavior when getting bad cubes"; break;
+		case PDR_DEQ_SMALL    : sfcMsg << "Get the smallest bad cube first from a priority heap";                  break;
+		case PDR_DEQ_DEPTH    : sfcMsg << "Get the bad cube farthest from the bad states first from a priority heap"; break;
+		case PDR_DEQ_ACTIVITY : sfcMsg << "Get the bad cube of the highest literal activity first from a priority heap"; break;
 	}
 	sfcMsg << endl;
 	sfcMsg << "             ";
@@ -513,6 +794,8 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 		case PDR_GEN_NORMAL : sfcMsg << "Try to remove a literal once a time during UNSAT generalization";                    break;
 		case PDR_GEN_APPROX : sfcMsg << "Try to remove a literal once a time during UNSAT generalization by approximate SAT"; break;
 		case PDR_GEN_IGNORE : sfcMsg << "Do not try to remove any literal during UNSAT generalization";                       break;
+		case PDR_GEN_CTG    : sfcMsg << "Try to remove a literal once a time during UNSAT generalization by blocking CTG"
+		                             << " (at most " << ctgNumLimit << " per literal, depth " << ctgDepthLimit << ")";           break;
 	}
 	sfcMsg << endl;
 	if(toRefineInf)
@@ -529,6 +812,10 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 		sfcMsg << "             Propagate blocked cubes from the currently minimum processing frame" << endl;
 	if(sortByBadDepth)
 		sfcMsg << "             Sort by the bad depth of proof obligation during queueing" << endl;
+	if(mainType == PDR_MAIN_MULTI)
+		sfcMsg << "             Check the outputs one after another on the same frames" << endl;
+	if(perFrameSolver)
+		sfcMsg << "             Use a solver for each frame holding only the clauses of the later frames" << endl;
 	size_t numActive = 0;
 	for(unsigned i = 0; i < PDR_STAT_TOTAL; ++i)
 		if(isPdrStatON(stats, PdrStatType(i)))
@@ -545,6 +832,12 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 			       << "- " << pdrVerboseStr[i] << endl;
 	if(checkIndInv)
 		sfcMsg << "             ** Check the inductive invariant at the end if found" << endl;
+	if(threadNum > 1)
+		sfcMsg << "             Run " << threadNum << " threads sharing the blocked cubes" << endl;
+	if(propThreadNum > 1)
+		sfcMsg << "             Propagate blocked cubes by " << propThreadNum << " threads" << endl;
+	if(patBlockNum != 0)
+		sfcMsg << "             Filter SAT queries by simulating " << patBlockNum << " x 64 states of the SAT solutions" << endl;
 
 	if(clsStimuT != PDR_CLS_STIMU_NONE)
 	{
@@ -636,9 +929,13 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 		case PDR_SIM_BACKWARD_INTERNAL:
 			throw CheckerErr("Backward ternary simulation with internal signal is not implemented yet!");
 			break;
+
+		case PDR_SIM_LIFT:
+			liftSolver = new PdrLiftSolver(this);
+			break;
 	}
 
-	if(isOrdDynamic())
+	if(isActivityON())
 	{
 		const size_t M = ntk->getMaxGateNum();
 		activity.init(M);
@@ -647,16 +944,33 @@ PdrChecker::PdrChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t
 	}
 
 	if(oblType == PDR_OBL_PUSH)
-		badDequeVec.emplace_back();
+		badDequeVec.emplace_back(),
+		badSetVec.emplace_back();
 
 	if(checkSelf)
 		throw CheckerErr("Self subsumption checking is not implemented yet!");
+	if(threadNum > 1 && (clsStimulator != 0 || oblStimulator != 0))
+		throw CheckerErr("Stimulation is not supported by parallel PDR yet!");
+	if(perFrameSolver && convertInNeedCone)
+		throw CheckerErr("Converting CNF formula only if needed is not supported by per-frame solvers yet!");
+	if(perFrameSolver && (clsStimulator != 0 || oblStimulator != 0))
+		throw CheckerErr("Stimulation is not supported by per-frame solvers yet!");
+	if(mainType == PDR_MAIN_MULTI && threadNum > 1)
+		throw CheckerErr("Checking all the outputs is not supported by parallel PDR yet!");
+	if(mainType == PDR_MAIN_MULTI && (clsStimulator != 0 || oblStimulator != 0))
+		throw CheckerErr("Checking all the outputs is not supported by stimulation yet!");
+	if(patBlockNum != 0 && simType == PDR_SIM_BACKWARD_NORMAL)
+		throw CheckerErr("Backward SAT generalization is not supported by the simulation filter yet!");
 
 	/* Convert all circuit for a timeframe */
 	convertCNF();
+	if(perFrameSolver)
+		frameSolverList.resize(1),
+		frameSolverList[0].s = solver;
 
 	/* Prepare for the initial state and infinite frame */
 	frame.emplace_back();
+	frameIndex.emplace_back();
 	newFrame();
 // TODO, fix this part
 addInitState();
@@ -664,16 +978,8 @@ addInitState();
 		frameConverted = 1;
 //	else addInitState();
 
-	#ifdef UsePatternCheckSAT
-	simValue.init(ntk->getMaxGateNum());
-	simValue[0] =  0;
-	patIdx      = 64;
-	matchTry    =  0;
-	matchFrame  =  0;
-	matchSAT    =  0;
-	matchTime   =  0;
-	simResult   = false;
-	#endif
+	if(patBlockNum != 0)
+		simValue.init(ntk->getMaxGateNum());
 
 	#ifdef CheckOblCommonPart
 	numInf = 0;
@@ -690,6 +996,17 @@ PdrChecker::~PdrChecker()
 		delete clsStimulator;
 	if(oblStimulator != 0)
 		delete oblStimulator;
+	for(PdrChecker* helper: helperList)
+		delete helper;
+	for(PdrPropSolver* ps: propSolverList)
+		delete ps;
+	for(size_t i = 1; i < frameSolverList.size(); ++i)
+		delete frameSolverList[i].s;
+	delete liftSolver;
+	delete cnfTemplate;
+	delete cutMap;
+	if(threadIdx == 0 && sharedStore != 0)
+		delete sharedStore;
 }
 
 auto
@@ -740,7 +1057,7 @@ PdrChecker::mergeInf(const vector<PdrCube>& indSet, bool pushAtBack, StatPtr<Pdr
 		}
 
 	if(isVerboseON(PDR_VERBOSE_STIMU))
-		cout << ", #original clause = " << tmp.size() << ", #added clause = " << s << endl;
+		sfcOut << ", #original clause = " << tmp.size() << ", #added clause = " << s << endl;
 	if(stimuStat.isON())
 		stimuStat->incInfClsNum(s);
 	tmp.resize(s);
@@ -762,6 +1079,7 @@ PdrChecker::mergeInf(const vector<PdrCube>& indSet, bool pushAtBack, StatPtr<Pdr
 			tmp.push_back(move(c));
 		inf.swap(tmp);
 	}
+	invalidateIndex(infIdx);
 }
 
 void
@@ -790,7 +1108,7 @@ PdrChecker::mergeFrames(const vector<vector<PdrCube>>& mergedFrame, bool pushAtB
 			}
 
 		if(isVerboseON(PDR_VERBOSE_STIMU))
-			cout << "For frame " << f << ": #original clause = " << tmp.size() << ", #added clause = " << s << endl;
+			sfcOut << "For frame " << f << ": #original clause = " << tmp.size() << ", #added clause = " << s << endl;
 		tmp.resize(s);
 
 		for(const PdrCube& c: tmp)
@@ -805,6 +1123,7 @@ PdrChecker::mergeFrames(const vector<vector<PdrCube>>& mergedFrame, bool pushAtB
 				tmp.push_back(move(c));
 			cur.swap(tmp);
 		}
+		invalidateIndex(f);
 	}
 	mergeInf(mergedFrame.back(), pushAtBack, stimuStat);
 }
@@ -821,6 +1140,8 @@ PdrChecker::cloneChecker()const
 	constexpr size_t noOblLimit    = 0;
 	constexpr size_t vbsOff        = 0;
 	constexpr bool   noCheckII     = false;
+	constexpr size_t singleThread  = 1;
+	constexpr size_t singlePropTh  = 1;
 
 	constexpr PdrClsStimuType noClsStimu = PDR_CLS_STIMU_NONE;
 	constexpr PdrOblStimuType noOblStimu = PDR_OBL_STIMU_NONE;
@@ -829,29 +1150,138 @@ PdrChecker::cloneChecker()const
 
 	PdrChecker* checker = new PdrChecker(ntk, fakeOutputIdx, noTrace, noTimeout, noMaxFrame, recycleNum, noStat,
 	                                     simType, ordType, oblType, deqType, prpType, genType,
-	                                     toRefineInf, convertInNeedCone, checkSelf, assertFrame, recycleByQuery, convertInNeedFrame, lazyProp, sortByBadDepth,
-	                                     noSatLimit, noOblLimit, vbsOff, noCheckII,
+	                                     toRefineInf, convertInNeedCone, checkSelf, assertFrame, recycleByQuery, recycleIncr, convertInNeedFrame, lazyProp, sortByBadDepth, perFrameSolver,
+	                                     noSatLimit, noOblLimit, vbsOff, noCheckII, singleThread, singlePropTh, dummy, dummy, dummy,
 	                                     noClsStimu, noShare, dummy, dummy, dummy,
 	                                     noOblStimu, noShare, dummy, dummy);
 	return checker;
 }
 
+PdrChecker*
+PdrChecker::cloneHelper(size_t idx)const
+{
+	// Let the helpers follow different orders of literals and obligations,
+	// otherwise they would block exactly the same cubes as thread 0
+	constexpr PdrOrdType ordList[] = { PDR_ORD_INDEX, PDR_ORD_ACTIVITY, PDR_ORD_DECAY,
+	                                   PDR_ORD_ACTIVITY_REVERSE, PDR_ORD_DECAY_REVERSE };
+	constexpr size_t ordNum = sizeof(ordList) / sizeof(PdrOrdType);
+	size_t ordIdx = 0;
+	for(; ordList[ordIdx] != ordType; ++ordIdx);
+	const PdrOrdType helperOrd = ordList[(ordIdx + idx) % ordNum];
+	const PdrDeqType helperDeq = (idx & 1) == 0 ? deqType : (deqType == PDR_DEQ_STACK ? PDR_DEQ_QUEUE : PDR_DEQ_STACK);
+
+	constexpr size_t noTimeout     = 0;
+	constexpr size_t noStat        = 0;
+	constexpr size_t noSatLimit    = 0;
+	constexpr size_t noOblLimit    = 0;
+	constexpr size_t vbsOff        = 0;
+	constexpr bool   noCheckII     = false;
+	constexpr size_t singleThread  = 1;
+	constexpr size_t singlePropTh  = 1;
+
+	constexpr PdrClsStimuType noClsStimu = PDR_CLS_STIMU_NONE;
+	constexpr PdrOblStimuType noOblStimu = PDR_OBL_STIMU_NONE;
+	constexpr PdrShareType    noShare    = PDR_SHARE_NONE;
+	constexpr size_t          dummy      = 0;
+
+	size_t outputIdx = 0;
+	for(; ntk->getOutputID(outputIdx) != property; ++outputIdx);
+	PdrChecker* checker = new PdrChecker(ntk->copyNtk(), outputIdx, trace, noTimeout, maxFrame, recycleNum, noStat,
+	                                     simType, helperOrd, oblType, helperDeq, prpType, genType,
+	                                     toRefineInf, convertInNeedCone, checkSelf, assertFrame, recycleByQuery, recycleIncr, convertInNeedFrame, lazyProp, sortByBadDepth, perFrameSolver,
+	                                     noSatLimit, noOblLimit, vbsOff, noCheckII, singleThread, singlePropTh, ctgNumLimit, ctgDepthLimit, patBlockNum,
+	                                     noClsStimu, noShare, dummy, dummy, dummy,
+	                                     noOblStimu, noShare, dummy, dummy);
+	checker->ntkIsCopied = true;
+	checker->disablePrintFrame();
+	checker->threadIdx   = idx;
+	checker->sharedStore = sharedStore;
+	return checker;
+}
+
 void
 PdrChecker::check()
 {
-	switch(checkInt())
-	{
-		case PDR_RESULT_SAT         : cout << "Observe a counter example at frame "         << curFrame << endl;
-		                              printTrace();                                                              break;
-		case PDR_RESULT_UNSAT       : cout << "Property proved at frame "                   << curFrame << endl;
-		                              checkAndPrintIndInv();                                                     break;
-		case PDR_RESULT_ABORT_FRAME : cout << "Cannot determinie the property up to frame " << maxFrame << endl; break;
-		case PDR_RESULT_ABORT_RES   : cout << "Cannot determinie the property"                          << endl; break;
+	if(mainType == PDR_MAIN_MULTI)
+		{ checkMulti(); return; }
+	PdrChecker* prover = this;
+	const PdrResultType r = threadNum > 1 ? checkIntParallel(prover) : checkInt();
+	if(prover != this)
+		sfcMsg << "Solved by helper thread " << prover->threadIdx << endl;
+	switch(r)
+	{
+		case PDR_RESULT_SAT         : sfcOut << "Observe a counter example at frame "         << prover->curFrame << endl;
+		                              prover->printTrace(); setResult(SFC_RESULT_SAT);                           break;
+		case PDR_RESULT_UNSAT       : sfcOut << "Property proved at frame "                   << prover->curFrame << endl;
+		                              prover->checkAndPrintIndInv(); setResult(SFC_RESULT_UNSAT);                break;
+		case PDR_RESULT_ABORT_FRAME : sfcOut << "Cannot determinie the property up to frame " << maxFrame << endl; break;
+		case PDR_RESULT_ABORT_RES   : sfcOut << "Cannot determinie the property"                          << endl; break;
 
 		default: assert(false);
 	}
 }
 
+/*
+	All the outputs are checked one after another on the same frames and solver,
+	since the blocked cubes only over-approximate the reachable states and never depend on the property
+	Each output restarts from frame 0 and walks through the existing frames before building new ones,
+	and once an output is proved, the frames after the empty one are merged into frame Inf for the others
+	The verdict of each output is reported as soon as it is decided
+*/
+void
+PdrChecker::checkMulti()
+{
+	size_t satNum = 0, unsatNum = 0, unknownNum = 0;
+	for(size_t i = 0, O = ntk->getOutputNum(); i < O; ++i)
+	{
+		property = ntk->getOutputID(i);
+		const string head = "Output " + to_string(i) + ": ";
+		if(ntk->noLatchInCone(i))
+		{
+			if(checkComb(head + "Observe a counter example at frame 0"))
+				satNum += 1;
+			else
+				sfcOut << head << "Property proved at frame 0" << endl, unsatNum += 1;
+			continue;
+		}
+
+		clearObl();
+		curFrame = 0;
+		const PdrResultType r = checkIntNormal();
+		switch(r)
+		{
+			case PDR_RESULT_SAT         : sfcOut << head << "Observe a counter example at frame "         << curFrame << endl;
+			                              printTrace(); satNum += 1;                                                         break;
+			case PDR_RESULT_UNSAT       : sfcOut << head << "Property proved at frame "                   << curFrame << endl;
+			                              unsatNum += 1;                                                                     break;
+			case PDR_RESULT_ABORT_FRAME : sfcOut << head << "Cannot determinie the property up to frame " << maxFrame << endl;
+			                              unknownNum += 1;                                                                   break;
+			case PDR_RESULT_ABORT_RES   : sfcOut << head << "Cannot determinie the property"                          << endl;
+			                              unknownNum += O - i;                                                               break;
+
+			default: assert(false);
+		}
+		if(r == PDR_RESULT_ABORT_RES)
+			break;
+		if(r == PDR_RESULT_UNSAT)
+		{
+			size_t f = 1;
+			for(; !frame[f].empty(); ++f);
+			assert(f < frame.size() - 1);
+			pushToFrameInf(f);
+			checkAndPrintIndInv();
+		}
+	}
+	clearObl();
+
+	sfcOut << "Proved " << unsatNum << ", falsified " << satNum << ", undetermined " << unknownNum
+	       << " out of " << ntk->getOutputNum() << " outputs" << endl;
+	if(satNum != 0)
+		setResult(SFC_RESULT_SAT);
+	else if(unknownNum == 0)
+		setResult(SFC_RESULT_UNSAT);
+}
+
 PdrResultType
 PdrChecker::checkInt()
 {
@@ -859,6 +1289,7 @@ PdrChecker::checkInt()
 	{
 		case PDR_MAIN_NORMAL     : return checkIntNormal();
 		case PDR_MAIN_ONE_BY_ONE : return checkIntOneByOne();
+		case PDR_MAIN_MULTI      : return checkIntNormal();
 		default: assert(false);    return PDR_RESULT_ERROR;
 	}
 }
@@ -869,6 +1300,7 @@ PdrChecker::startWithIndSet(const vector<PdrCube>& indSet)
 	for(const vector<PdrCube>& f: frame)
 		assert(f.empty());
 	frame.back() = indSet;
+	invalidateIndex(frame.size() - 1);
 	addBlockedCubeInf();
 }
 
@@ -879,6 +1311,7 @@ PdrChecker::checkIntNormal()
 	{
 		while(true)
 		{
+			importSharedCubes();
 			if(oblType == PDR_OBL_PUSH)
 				if(!recBlockCube(PdrTCube(FRAME_NULL, PdrCube())))
 					return PDR_RESULT_SAT;
@@ -889,6 +1322,14 @@ PdrChecker::checkIntNormal()
 				//finish blocking
 				if(curFrame == maxFrame)
 					return PDR_RESULT_ABORT_FRAME;
+				// The frames kept from the previous outputs are walked through before a new one is built
+				if(mainType == PDR_MAIN_MULTI && curFrame + 2 < frame.size())
+				{
+					if(curFrame != 0 && frame[curFrame].empty())
+						return PDR_RESULT_UNSAT;
+					curFrame += 1;
+					continue;
+				}
 				if(propBlockedCubes())
 					return PDR_RESULT_UNSAT;
 			}
@@ -899,6 +1340,59 @@ PdrChecker::checkIntNormal()
 	catch(const CheckerBreak&) { return PDR_RESULT_ABORT_RES; }
 }
 
+/*
+	Parallel PDR in the style of lemma sharing
+	Thread 0 is this checker, and the helpers run on their own copies of the network
+	Every thread publishes the cubes it blocks, and validates the cubes of the others
+	by its own solver before adding them, so the frames of each thread stay sound
+	The first thread reaching a verdict stops the others
+*/
+PdrResultType
+PdrChecker::checkIntParallel(PdrChecker*& prover)
+{
+	assert(threadIdx == 0 && sharedStore == 0 && helperList.empty());
+	sharedStore = new PdrSharedStore;
+	sfcMsg.unsetActive();
+	for(size_t i = 1; i < threadNum; ++i)
+		helperList.push_back(cloneHelper(i));
+	sfcMsg.setActive();
+
+	// The helpers are constructed here, so their threads continue the reference counter of this one
+	const unsigned refBase = AigGate::getGlobalRef();
+	vector<PdrResultType> resultList(threadNum, PDR_RESULT_ABORT_RES);
+	vector<thread> threadList;
+	threadList.reserve(helperList.size());
+	for(PdrChecker* helper: helperList)
+		threadList.emplace_back([helper, refBase, &resultList]()
+		{
+			AigGate::setGlobalRef(refBase);
+			PdrResultType& r = resultList[helper->threadIdx];
+			// An error must not leave the thread, so the helper gives up and stops the others
+			try
+			{
+				if(r = helper->checkInt(); r == PDR_RESULT_SAT || r == PDR_RESULT_UNSAT)
+					helper->sharedStore->claimWinner(helper->threadIdx);
+			}
+			catch(const CheckerErr& ce)
+			{
+				cerr << ce.getErrStr() << endl;
+				r = PDR_RESULT_ABORT_RES;
+				helper->sharedStore->abort();
+			}
+		});
+
+	if(resultList[0] = checkInt(); resultList[0] == PDR_RESULT_SAT || resultList[0] == PDR_RESULT_UNSAT)
+		sharedStore->claimWinner(0);
+	// Stop the helpers if thread 0 finishes or aborts by itself
+	sharedStore->abort();
+	for(thread& t: threadList)
+		t.join();
+
+	if(const size_t w = sharedStore->getWinner(); w != MAX_SIZE_T)
+		{ if(w != 0) prover = helperList[w-1]; return resultList[w]; }
+	return resultList[0];
+}
+
 PdrResultType
 PdrChecker::checkIntOneByOne()
 {
@@ -939,7 +1433,7 @@ PdrChecker::checkIntOneByOne()
 				//TODO
 			}
 			for(size_t i = 1; i < emptyFrame; ++i)
-				frame[i].clear();
+				frame[i].clear(), invalidateIndex(i);
 		}
 	}
 }
@@ -978,8 +1472,7 @@ PdrChecker::recBlockCube(const PdrTCube& notPTCube)
 		{ assert(oblType == PDR_OBL_PUSH); return true; }
 	auto checkEmpty = [this, &checkFrame]()
 	{
-		if(deqType == PDR_DEQ_STACK) badDequeVec[checkFrame].pop_back();
-		else                         badDequeVec[checkFrame].pop_front();
+		popBadCube(checkFrame);
 		if(badDequeVec[checkFrame].empty()) checkFrame += 1;
 	};
 	oblTreeSize = badDequeVec[curFrame].size();
@@ -988,13 +1481,13 @@ PdrChecker::recBlockCube(const PdrTCube& notPTCube)
 		assert(!badDequeVec[checkFrame].empty());
 		if(checkFrame == 0)
 			return returnBy(false);
-		const PdrCube& badCube = deqType == PDR_DEQ_STACK ? badDequeVec[checkFrame].back()
-		                                                  : badDequeVec[checkFrame].front();
+		importSharedCubes();
+		const PdrCube& badCube = getBadCube(checkFrame);
 		if(isVerboseON(PDR_VERBOSE_OBL))
-			cout << RepeatChar('-', 36) << endl
-			     << "Check: frame = " << checkFrame
-			     << ", " << badCube << endl
-			     << RepeatChar('-', 36) << endl;
+			sfcOut << RepeatChar('-', 36) << endl
+			       << "Check: frame = " << checkFrame
+			       << ", " << badCube << endl
+			       << RepeatChar('-', 36) << endl;
 		PdrTCube badTCube(checkFrame, badCube);
 		if(lazyProp && minBlockFrame > checkFrame)
 			minBlockFrame = checkFrame;
@@ -1012,6 +1505,7 @@ PdrChecker::recBlockCube(const PdrTCube& notPTCube)
 				assert(newTCube.getFrame() >= checkFrame);
 				assert(newTCube.getFrame() < actVar.size() || newTCube.getFrame() == FRAME_INF);
 				addBlockedCube(newTCube);
+				shareBlockedCube(newTCube);
 				if(oblType != PDR_OBL_IGNORE)
 					if(newTCube.getFrame() != FRAME_INF)
 						if(newTCube.getFrame() < curFrame || oblType == PDR_OBL_PUSH)
@@ -1047,10 +1541,8 @@ PdrChecker::isBlocked(const PdrTCube& badTCube)const
 	if(cubeStat.isON())
 		cubeStat->startTime();
 	for(; f < maxF; ++f)
-		for(const PdrCube& frameCube: frame[f])
-			if(subsume(frameCube, badTCube.getCube()))
-				goto DONE;
-DONE:
+		if(isSubsumedInFrame(badTCube.getCube(), f))
+			break;
 	if(cubeStat.isON())
 		cubeStat->finishTime();
 	assert(f <= maxF);
@@ -1089,11 +1581,11 @@ PdrChecker::generalize(const PdrTCube& s)
 	PdrTCube newTCube(newF, PdrCube(genCube, isOrdDynamic()));
 	if(isVerboseON(PDR_VERBOSE_GEN))
 	{
-		cout << RepeatChar('-', 36) << endl
-		     << "UNSAT generalization: frame = ";
-		if(newTCube.getFrame() == FRAME_INF) cout << "Inf"; else cout << newTCube.getFrame();
-		cout << ", " << newTCube.getCube() << endl
-		     << RepeatChar('-', 36) << endl;
+		sfcOut << RepeatChar('-', 36) << endl
+		       << "UNSAT generalization: frame = ";
+		if(newTCube.getFrame() == FRAME_INF) sfcOut << "Inf"; else sfcOut << newTCube.getFrame();
+		sfcOut << ", " << newTCube.getCube() << endl
+		       << RepeatChar('-', 36) << endl;
 	}
 	return newTCube;
 }
@@ -1115,17 +1607,14 @@ PdrChecker::generalizeDefault(size_t& newF)
 
 	if(genType != PDR_GEN_IGNORE)
 	{
+		size_t ctgNum = 0;
 		for(size_t i = 0; i < genCube.size();)		
 			if(isInv(genCube[i]) || numPos > 1)
 			{
-				#ifdef UsePatternCheckSAT
-				checkPatForSat(newF - 1, i);
-				#endif
-				solver->clearAssump();
-				const Var act = addCurNotState(genCube, i);
-				activateFrame(newF-1); //it's fine even if newF is FRAME_INF
-				addNextState(genCube, i);
-				if(genType == PDR_GEN_APPROX ? !satSolveLimited() : !satSolve())
+				PdrCube ctg;
+				// The solver is skipped if a stored state already satisfies the query
+				const Var act = checkPatForSat(newF-1, i) ? var_Undef : setGenQuery(newF-1, i);
+				if(act != var_Undef && (genType == PDR_GEN_APPROX ? !satSolveLimited() : !satSolve()))
 				{
 					if(!isInv(genCube[i]))
 						numPos -= 1;
@@ -1146,12 +1635,22 @@ PdrChecker::generalizeDefault(size_t& newF)
 							genCube[s2++] = genCube[j];
 						else if(!isInv(genCube[j]))
 							numPos -= 1;
+					if(ctgNum != 0 && unsatGenStat.isON())
+						unsatGenStat->incCtgRemoveCount(genCube.size() - s2);
 					genCube.resize(s2);
 					i = s1;
+					ctgNum = 0;
 					assert(!isInitial(genCube));
 				}
-				else i += 1;
-				disableActVar(act);
+				else if(ctg = getCtg(newF, i, ctgNum); ctg.isNone())
+					i += 1, ctgNum = 0;
+				if(act != var_Undef)
+					disableActVar(act);
+				if(!ctg.isNone())
+				{
+					if(blockCtg(ctg, newF - 1)) ctgNum += 1;
+					else i += 1, ctgNum = 0;
+				}
 				CheckBreakPdr(true);
 			}
 			else i += 1;
@@ -1166,9 +1665,9 @@ PdrChecker::generalizeDefault(size_t& newF)
 
 	while(newF < actVar.size() - 1)
 	{
-		#ifdef UsePatternCheckSAT
-		checkPatForSat(newF, MAX_SIZE_T);
-		#endif
+		if(checkPatForSat(newF, MAX_SIZE_T))
+			break;
+		selectSolver(newF);
 		solver->clearAssump();
 		const Var act = addCurNotState(genCube);
 		activateFrame(newF);
@@ -1208,14 +1707,14 @@ PdrChecker::generalizeClause(size_t& newF)
 
 	if(genType != PDR_GEN_IGNORE)
 	{
+		size_t ctgNum = 0;
 		for(size_t i = 0; i < genCube.size();)
 			if(getInitValue(getGateID(genCube[i])) == ThreeValue_DC)
 			{
-				solver->clearAssump();
-				const Var act = addCurNotState(genCube, i);
-				activateFrame(newF-1); //it's fine even if newF is FRAME_INF
-				addNextState(genCube, i);
-				if(genType == PDR_GEN_APPROX ? !satSolveLimited() : !satSolve())
+				PdrCube ctg;
+				// The solver is skipped if a stored state already satisfies the query
+				const Var act = checkPatForSat(newF-1, i) ? var_Undef : setGenQuery(newF-1, i);
+				if(act != var_Undef && (genType == PDR_GEN_APPROX ? !satSolveLimited() : !satSolve()))
 				{
 					newF = findLowestActPlus1(newF-1);
 					size_t s1 = 0;
@@ -1228,12 +1727,22 @@ PdrChecker::generalizeClause(size_t& newF)
 						if(solver->inConflict(getGateID(genCube[j]), 1) ||
 						   getInitValue(getGateID(genCube[j])) != ThreeValue_DC)
 							genCube[s2++] = genCube[j];
+					if(ctgNum != 0 && unsatGenStat.isON())
+						unsatGenStat->incCtgRemoveCount(genCube.size() - s2);
 					genCube.resize(s2);
 					i = s1;
+					ctgNum = 0;
 					assert(!isInitial(genCube));
 				}
-				else i += 1;
-				disableActVar(act);
+				else if(ctg = getCtg(newF, i, ctgNum); ctg.isNone())
+					i += 1, ctgNum = 0;
+				if(act != var_Undef)
+					disableActVar(act);
+				if(!ctg.isNone())
+				{
+					if(blockCtg(ctg, newF - 1)) ctgNum += 1;
+					else i += 1, ctgNum = 0;
+				}
 				CheckBreakPdr(true);
 			}
 			else
@@ -1252,6 +1761,9 @@ PdrChecker::generalizeClause(size_t& newF)
 
 	while(newF < actVar.size() - 1)
 	{
+		if(checkPatForSat(newF, MAX_SIZE_T))
+			break;
+		selectSolver(newF);
 		solver->clearAssump();
 		const Var act = addCurNotState(genCube);
 		activateFrame(newF);
@@ -1295,14 +1807,14 @@ PdrChecker::generalizeCube(size_t& newF)
 
 	if(genType != PDR_GEN_IGNORE)
 	{
+		size_t ctgNum = 0;
 		for(size_t i = 0; i < genCube.size();)		
 			if(!diffPolar(genCube[i]) || numDiffPolar > 1)
 			{
-				solver->clearAssump();
-				const Var act = addCurNotState(genCube, i);
-				activateFrame(newF-1); //it's fine even if newF is FRAME_INF
-				addNextState(genCube, i);
-				if(genType == PDR_GEN_APPROX ? !satSolveLimited() : !satSolve())
+				PdrCube ctg;
+				// The solver is skipped if a stored state already satisfies the query
+				const Var act = checkPatForSat(newF-1, i) ? var_Undef : setGenQuery(newF-1, i);
+				if(act != var_Undef && (genType == PDR_GEN_APPROX ? !satSolveLimited() : !satSolve()))
 				{
 					if(diffPolar(genCube[i]))
 						numDiffPolar -= 1;
@@ -1323,12 +1835,22 @@ PdrChecker::generalizeCube(size_t& newF)
 							genCube[s2++] = genCube[j];
 						else if(diffPolar(genCube[j]))
 							numDiffPolar -= 1;
+					if(ctgNum != 0 && unsatGenStat.isON())
+						unsatGenStat->incCtgRemoveCount(genCube.size() - s2);
 					genCube.resize(s2);
 					i = s1;
+					ctgNum = 0;
 					assert(!isInitial(genCube));
 				}
-				else i += 1;
-				disableActVar(act);
+				else if(ctg = getCtg(newF, i, ctgNum); ctg.isNone())
+					i += 1, ctgNum = 0;
+				if(act != var_Undef)
+					disableActVar(act);
+				if(!ctg.isNone())
+				{
+					if(blockCtg(ctg, newF - 1)) ctgNum += 1;
+					else i += 1, ctgNum = 0;
+				}
 				CheckBreakPdr(true);
 			}
 			else i += 1;
@@ -1343,6 +1865,9 @@ PdrChecker::generalizeCube(size_t& newF)
 
 	while(newF < actVar.size() - 1)
 	{
+		if(checkPatForSat(newF, MAX_SIZE_T))
+			break;
+		selectSolver(newF);
 		solver->clearAssump();
 		const Var act = addCurNotState(genCube);
 		activateFrame(newF);
@@ -1372,6 +1897,56 @@ PdrChecker::generalizeCube(size_t& newF)
 		unsatGenStat->finishPushTime();
 }
 
+/*
+	After failing to remove a literal, the current state of the SAT solution is a counterexample to generalization (CTG)
+	The CTG lifted by ternary simulation is blocked relative to the previous frame if possible,
+	and then the removal is tried again because the CTG no longer satisfies the frame
+*/
+PdrCube
+PdrChecker::getCtg(size_t newF, size_t skip, size_t ctgNum)const
+{
+	if(genType != PDR_GEN_CTG || ctgNum >= ctgNumLimit || ctgDepth >= ctgDepthLimit)
+		return PdrCube();
+	// The CTG of frame 0 or Inf has no previous frame to be blocked relative to
+	if(newF < 2 || newF == FRAME_INF)
+		return PdrCube();
+	vector<AigGateID> target;
+	target.reserve(genCube.size() - 1);
+	for(size_t i = 0, n = genCube.size(); i < n; ++i)
+		if(i != skip)
+			target.push_back(ntk->getGate(getGateID(genCube[i]))->getFanIn0ID());
+	vector<AigGateLit> saved(move(genCube));
+	PdrCube ctg = terSim(target);
+	genCube = move(saved);
+	if(unsatGenStat.isON())
+		unsatGenStat->incCtgFoundCount();
+	return isInitial(ctg) ? PdrCube() : ctg;
+}
+
+bool
+PdrChecker::blockCtg(const PdrCube& ctg, size_t f)
+{
+	if(unsatGenStat.isON())
+		unsatGenStat->finishRemoveTime();
+	vector<AigGateLit> saved(move(genCube));
+	PdrTCube ctgTCube = solveRelative(PdrTCube(f, ctg));
+	const bool blocked = ctgTCube.getFrame() != FRAME_NULL;
+	if(blocked)
+	{
+		ctgDepth += 1;
+		ctgTCube = generalize(ctgTCube);
+		ctgDepth -= 1;
+		addBlockedCube(ctgTCube);
+		shareBlockedCube(ctgTCube);
+		if(unsatGenStat.isON())
+			unsatGenStat->incCtgBlockCount();
+	}
+	genCube = move(saved);
+	if(unsatGenStat.isON())
+		unsatGenStat->startTime();
+	return blocked;
+}
+
 bool
 PdrChecker::propBlockedCubes()
 {
@@ -1389,6 +1964,20 @@ PdrChecker::propBlockedCubes()
 	if(clsStimulator != 0)
 		clsStimulator->stimulateAtEndOfFrame();
 
+	if(propThreadNum > 1)
+	{
+		if(propSolverList.empty())
+		{
+			// Build the template and the flat view here since the solvers load and convert in their own threads
+			getCnfTemplate();
+			ntk->getFlatView();
+			for(size_t t = 0; t < propThreadNum; ++t)
+				propSolverList.push_back(new PdrPropSolver(this));
+		}
+		for(PdrPropSolver* ps: propSolverList)
+			ps->reset();
+	}
+
 	if(propStat.isON())
 		propStat->doOneTime(),
 		propStat->startTime();
@@ -1407,27 +1996,36 @@ PdrChecker::propBlockedCubes()
 			newFrame();
 
 		vector<PdrCube> tmp(frame[f]);
-		for(const PdrCube& c: tmp)
-			if(!c.getMarkA())
+		vector<size_t> propFrame;
+		vector<vector<AigGateLit>> propLits;
+		const bool inParallel = propSolverList.size() > 1 && tmp.size() > 1;
+		if(inParallel)
+			propInParallel(f, tmp, propFrame, propLits);
+		for(size_t i = 0, n = tmp.size(); i < n; ++i)
+			if(const PdrCube& c = tmp[i]; !c.getMarkA())
 			{
 				if(propStat.isON())
 					propStat->incPropCubeCount();
-				if(PdrTCube s = solveRelative(PdrTCube(f+1, c), NOIND);
+				// The results of parallel propagation are merged in the order of the cubes
+				if(PdrTCube s = !inParallel ? solveRelative(PdrTCube(f+1, c), NOIND)
+				                            : PdrTCube(propFrame[i], propFrame[i] == FRAME_NULL ? PdrCube() : PdrCube(propLits[i]));
 				   s.getFrame() != FRAME_NULL)
 				{
 					if(propStat.isON())
 						propStat->incPropSuccessCount();
 					if(isVerboseON(PDR_VERBOSE_PROP))
 					{
-						cout << RepeatChar('-', 36) << endl
-						     << "Propagate cube from frame " << f << " to ";
-						if(s.getFrame() == FRAME_INF) cout << "Inf"; else cout << s.getFrame();
-						cout << ":"                       << endl
-						     << "Before: " << c           << endl
-						     << "After:  " << s.getCube() << endl
-						     << RepeatChar('-', 36)       << endl;
+						sfcOut << RepeatChar('-', 36) << endl
+						       << "Propagate cube from frame " << f << " to ";
+						if(s.getFrame() == FRAME_INF) sfcOut << "Inf"; else sfcOut << s.getFrame();
+						sfcOut << ":"                       << endl
+						       << "Before: " << c           << endl
+						       << "After:  " << s.getCube() << endl
+						       << RepeatChar('-', 36)       << endl;
 					}
 					addBlockedCube(s, c.getSize() == s.getCube().getSize() ? f : 1);
+					for(PdrPropSolver* ps: propSolverList)
+						ps->addBlockedCube(s.getFrame(), s.getCube());
 				}
 				CheckBreakPdr(false);
 				checkRecycle();
@@ -1455,23 +2053,137 @@ PdrChecker::propBlockedCubes()
 	return returnBy(false);
 }
 
+void
+PdrChecker::shareBlockedCube(const PdrTCube& blockTCube)const
+{
+	if(sharedStore != 0)
+		sharedStore->publish(threadIdx, blockTCube.getFrame(), blockTCube.getCube());
+}
+
+void
+PdrChecker::importSharedCubes()
+{
+	if(sharedStore == 0 || !sharedStore->hasNew(sharedReadNum))
+		return;
+	vector<pair<size_t, vector<AigGateLit>>> cubeList;
+	sharedStore->fetch(threadIdx, sharedReadNum, cubeList);
+	for(const auto& [f, litList]: cubeList)
+	{
+		// A cube blocked at frame f by another thread is also blocked at the frames before f,
+		// but it is only added after being proved relative inductive by our own solver
+		const size_t topFrame = actVar.size() - 1;
+		const size_t checkF = f > topFrame ? topFrame : f;
+		if(checkF == 0)
+			continue;
+		PdrCube cube(litList);
+		if(checkIsSubsumed(cube, checkF, frame.size() - 1))
+			continue;
+		if(PdrTCube s = solveRelative(PdrTCube(checkF, cube)); s.getFrame() != FRAME_NULL)
+			addBlockedCube(s);
+		CheckBreakPdr(false);
+		checkRecycle();
+	}
+}
+
+/*
+	Every propagation solver checks the cubes i with i % T == t,
+	so the sequence of queries on each solver does not depend on the scheduling of threads
+*/
+void
+PdrChecker::propInParallel(size_t f, const vector<PdrCube>& cubeList,
+                           vector<size_t>& propFrame, vector<vector<AigGateLit>>& propLits)
+{
+	const size_t n = cubeList.size(), T = propSolverList.size();
+	propFrame.assign(n, FRAME_NULL);
+	propLits.resize(n);
+	auto solveSlice = [&](size_t t)
+	{
+		for(size_t i = t; i < n; i += T)
+			if(!cubeList[i].getMarkA())
+				propFrame[i] = propSolverList[t]->solveRelative(f+1, cubeList[i], propLits[i]);
+	};
+	vector<thread> threadList;
+	threadList.reserve(T - 1);
+	for(size_t t = 1; t < T; ++t)
+		threadList.emplace_back(solveSlice, t);
+	solveSlice(0);
+	for(thread& th: threadList)
+		th.join();
+}
+
+void
+PdrChecker::PdrPropSolver::load(size_t f)
+{
+	solver->resetSolver();
+	actVar.clear();
+	solver->loadCNF(checker->getCnfTemplate(), 0);
+	syncActVar();
+	loaded = true;
+	for(size_t ff = f == 0 ? 1 : f; ff < actVar.size(); ++ff)
+		for(const PdrCube& c: checker->frame[ff])
+			addBlockedCube(ff, c);
+	for(const PdrCube& c: checker->frame.back())
+		addBlockedCube(FRAME_INF, c);
+}
+
+void
+PdrChecker::PdrPropSolver::syncActVar()
+{
+	while(actVar.size() < checker->actVar.size())
+		actVar.push_back(solver->newVar());
+}
+
+void
+PdrChecker::PdrPropSolver::addBlockedCube(size_t f, const PdrCube& c)
+{
+	// The cubes are loaded from the frames at the first query
+	if(!loaded)
+		return;
+	syncActVar();
+	if(f != FRAME_INF)
+		litList.emplace_back(actVar[f], true);
+	for(unsigned i = 0; i < c.getSize(); ++i)
+		litList.emplace_back(solver->getVarInt(getGateID(c.getLit(i)), 0), !isInv(c.getLit(i)));
+	solver->addClause(litList);
+	litList.clear();
+}
+
+size_t
+PdrChecker::PdrPropSolver::solveRelative(size_t f, const PdrCube& c, vector<AigGateLit>& genLits)
+{
+	assert(f > 0);
+	if(!loaded)
+		load(f-1);
+	syncActVar();
+	solver->clearAssump();
+	for(size_t ff = f - 1; ff < actVar.size(); ++ff)
+		solver->addAssump(actVar[ff], false);
+	for(unsigned i = 0; i < c.getSize(); ++i)
+		solver->addAssump(c.getLit(i), 1);
+	if(solver->solve())
+		return FRAME_NULL;
+	checker->unsatGen(c, solver, genLits);
+	return findLowestActPlus1(f-1, solver, actVar);
+}
+
 PdrCube
 PdrChecker::getNotPCube()const
 {
-	#ifdef UsePatternCheckSAT
-	checkPatForSat(curFrame);
-	#endif
 	if(!targetCube.isNone())
 	{
+		selectSolver(curFrame);
 		solver->clearAssump();
 		addCurState(targetCube);
 		activateFrame(curFrame);
 		return satSolve() ? targetCube : PdrCube();
 	}
+	else if(checkPatForSat(curFrame))
+		return terSim(vector<AigGateID>(1, ntk->getGate(property)->getFanIn0ID()));
 	else
 	{
+		selectSolver(curFrame);
 		if(convertInNeedCone)
-			solver->convertToCNF(property, 0);
+			solver->convertToCNF(property, 0, false);
 		solver->clearAssump();
 		solver->addAssump(property, 0, false);
 		activateFrame(curFrame);
@@ -1485,6 +2197,7 @@ PdrChecker::isBlockedSAT(const PdrTCube& badTCube)const
 	constexpr bool checkBlockedUseSAT = false;
 	if constexpr(checkBlockedUseSAT)
 	{
+		selectSolver(badTCube.getFrame());
 		solver->clearAssump();
 		activateFrame(badTCube.getFrame());
 		addCurState(badTCube.getCube());
@@ -1534,9 +2247,9 @@ PdrChecker::isInitial(const PdrCube& cube)const
 PdrTCube
 PdrChecker::solveRelative(const PdrTCube& s, SolveType type)const
 {
-	#ifdef UsePatternCheckSAT
-	checkPatForSat(s.getFrame() - 1, s.getCube());
-	#endif
+	if(checkPatForSat(s.getFrame()-1, s.getCube(), type != NOIND))
+		return PdrTCube(FRAME_NULL, type == EXTRACT ? terSim(genTarget(s.getCube()), &(s.getCube())) : PdrCube());
+	selectSolver(s.getFrame()-1);
 	solver->clearAssump();
 	struct DisableAct {
 		~DisableAct() { if(act != var_Undef) c->disableActVar(act); }
@@ -1554,8 +2267,11 @@ PdrChecker::newFrame()
 {
 	frame.push_back(move(frame.back()));
 	frame[frame.size()-2].clear();
+	frameIndex.push_back(move(frameIndex.back()));
+	frameIndex[frameIndex.size()-2] = PdrFrameIndex();
 	actVar.push_back(solver->newVar());
 	badDequeVec.emplace_back();
+	badSetVec.emplace_back();
 	assert(actVar.size() == frame.size() - 1);
 	assert(actVar.size() == badDequeVec.size() ||
 	       (oblType == PDR_OBL_PUSH && actVar.size() + 1 == badDequeVec.size()));
@@ -1584,8 +2300,9 @@ PdrChecker::addBlockedCube(const PdrTCube& blockTCube, size_t initF)
 		for(size_t i = 0; i < frame[f].size(); ++i)
 			assert(!frame[f][i].isNone());
 
-	if(isOrdDynamic())
+	if(isActivityON())
 	{
+		actBumpNum += 1;
 		for(unsigned i = 0; i < blockCube.getSize(); ++i)
 			if((activity[getGateID(blockCube.getLit(i))] += actInc) > 1e100)
 			{
@@ -1601,17 +2318,35 @@ PdrChecker::addBlockedCube(const PdrTCube& blockTCube, size_t initF)
 	}
 
 	frame[k].push_back(blockCube);
+	if(frameIndex[k].isValid(frame[k].size() - 1))
+		frameIndex[k].add(blockCube);
 	// Actually it must hold currently, but we do not exclude the possibility for future
-	if(blockFrame >= frameConverted)
-		addBlockedCubeFrame(blockFrame, blockCube);
+	if(!perFrameSolver)
+	{
+		if(blockFrame >= frameConverted)
+			addBlockedCubeFrame(blockFrame, blockCube);
+	}
+	else
+	{
+		// Solver i holds the cube only if it is blocked at frame i or later
+		const size_t oriIdx = curSolverIdx;
+		for(size_t i = 0; i < frameSolverList.size() && i <= blockFrame; ++i)
+			if(frameSolverList[i].s != 0)
+			{
+				switchSolver(i);
+				if(blockFrame >= frameConverted)
+					addBlockedCubeFrame(blockFrame, blockCube);
+			}
+		switchSolver(oriIdx);
+	}
 
 	if(isVerboseON(PDR_VERBOSE_BLK))
 	{
-		cout << RepeatChar('-', 36) << endl
-		     << "Add blocked Cube: frame = ";
-		if(blockFrame == FRAME_INF) cout << "Inf"; else cout << blockFrame;
-		cout << ", " << blockCube << endl
-		     << RepeatChar('-', 36) << endl;
+		sfcOut << RepeatChar('-', 36) << endl
+		       << "Add blocked Cube: frame = ";
+		if(blockFrame == FRAME_INF) sfcOut << "Inf"; else sfcOut << blockFrame;
+		sfcOut << ", " << blockCube << endl
+		       << RepeatChar('-', 36) << endl;
 	}
 
 	if(cubeStat.isON())
@@ -1680,6 +2415,7 @@ PdrChecker::terSim(const vector<AigGateID>& target, const PdrCube* prevCube)cons
 		case PDR_SIM_FORWARD_EVENT     : terSimForwardEvent    (target); break;
 		case PDR_SIM_BACKWARD_NORMAL   : terSimBackwardNormal  (target); break;
 		case PDR_SIM_BACKWARD_INTERNAL : terSimBackwardInternal(target); break;
+		case PDR_SIM_LIFT              : terSimLift            (target); break;
 	}
 	PdrCube c(genCube, true, prevCube, trace);
 	numObl += 1;
@@ -1696,9 +2432,9 @@ PdrChecker::terSim(const vector<AigGateID>& target, const PdrCube* prevCube)cons
 		terSimStat->incRemoveCount(latchInCone - size_t(c.getSize()));
 	}
 	if(isVerboseON(PDR_VERBOSE_TERSIM))
-		cout << RepeatChar('-', 36) << endl
-		     << "Generate proof obligation: " << c << endl
-		     << RepeatChar('-', 36) << endl;
+		sfcOut << RepeatChar('-', 36) << endl
+		       << "Generate proof obligation: " << c << endl
+		       << RepeatChar('-', 36) << endl;
 	return c;
 }
 
@@ -1710,7 +2446,7 @@ PdrChecker::terSimForwardNormal(const vector<AigGateID>& target)const
 	/* Constant Propagation */
 	for(size_t i = 0, I = ntk->getInputNum(); i < I; ++i)
 		if(AigGateID id = ntk->getInputID(i); ntk->getGate(id)->isGlobalRef())
-			terSimSup.setValue(id, solver->getValueBool(id, 0));
+			terSimSup.setValue(id, getInputValue(i));
 	for(AigGateLit lit: genCube)
 		terSimSup.setValue(getGateID(lit), ThreeValue_DC);
 	terSimSup.simDfsList();
@@ -1719,22 +2455,7 @@ PdrChecker::terSimForwardNormal(const vector<AigGateID>& target)const
 	/* Ternary Simulation */
 	for(AigGateLit lit: genCube)
 		terSimSup.setValue(getGateID(lit), !isInv(lit));
-	size_t s = 0;
-	for(size_t i = 0, n = genCube.size(); i < n; ++i)
-	{
-		terSimSup.setValue(getGateID(genCube[i]), ThreeValue_DC);
-		terSimSup.simDfsList();
-		bool necessary = false;
-		for(AigGateID t: target)
-			if(terSimSup.getValue(t) == ThreeValue_DC)
-				{ necessary = true; break; }
-		if(necessary)
-		{
-			terSimSup.setValue(getGateID(genCube[i]), !isInv(genCube[i]));
-			genCube[s++] = genCube[i];
-		}
-	}
-	genCube.resize(s);
+	terSimSup.dropByParaSim(genCube, target);
 }
 
 void
@@ -1745,7 +2466,7 @@ PdrChecker::terSimForwardEvent(const vector<AigGateID>& target)const
 	/* Do First Simulation */
 	for(size_t i = 0, I = ntk->getInputNum(); i < I; ++i)
 		if(AigGateID id = ntk->getInputID(i); ntk->getGate(id)->isGlobalRef())
-			terSimSup.setValue(id, solver->getValueBool(id, 0));
+			terSimSup.setValue(id, getInputValue(i));
 	for(AigGateLit lit: genCube)
 		terSimSup.setValue(getGateID(lit), !isInv(lit));
 	terSimSup.simDfsList();
@@ -1785,41 +2506,62 @@ PdrChecker::terSimBackwardInternal(const vector<AigGateID>&)const
 }
 
 void
-PdrChecker::satGenBySAT(const vector<AigGateLit>& target)const
+PdrChecker::terSimLift(const vector<AigGateID>& target)const
 {
+	genSimCand(target);
+	vector<AigGateLit> inputs;
+	for(size_t i = 0, I = ntk->getInputNum(); i < I; ++i)
+		if(AigGateID id = ntk->getInputID(i); ntk->getGate(id)->isGlobalRef())
+			inputs.push_back(makeToLit(id, !getInputValue(i)));
+	liftSolver->lift(target, inputs, genCube);
+}
+
+/*
+	The lifting solver holds the combinational logic of the targets, with the latches as free variables,
+	so its clauses and activity are never mixed with the frames of the main solver
+	With the inputs and the state fixed, the values of the targets are implied,
+	and keeping them under the negation of the targets gives an UNSAT core over the state
+	The state literals outside the core are dropped, so the cube still reaches the targets under the same inputs
+*/
+void
+PdrChecker::PdrLiftSolver::lift(const vector<AigGateID>& target, const vector<AigGateLit>& inputs, vector<AigGateLit>& cube)
+{
+	for(AigGateID id: target)
+		solver->convertToCNF(id, 0);
+	auto addAssumps = [this, &inputs, &cube]()
+	{
+		for(AigGateLit lit: inputs)
+			solver->addAssump(lit, 0);
+		for(AigGateLit lit: cube)
+			solver->addAssump(lit, 0);
+	};
+
+	solver->clearAssump();
+	addAssumps();
+	bool result = solver->solve();
+	assert(result);
 	const Var act = solver->newVar();
 	litList.emplace_back(act, true);
-	for(AigGateLit lit: target)
-		litList.emplace_back(solver->getVarInt(getGateID(lit), 1), !isInv(lit));
+	for(AigGateID id: target)
+		litList.emplace_back(solver->getVarInt(id, 0), solver->getValueBool(id, 0));
 	solver->addClause(litList);
 	litList.clear();
-//	terSimSup.markDfsCone(target);
-	unsigned numPI = 0;
-	for(size_t i = 0, I = ntk->getInputNum(); i < I; ++i)
-		if(ntk->getInputNorm(i)->isGlobalRef())
-			numPI += 1;
-	Array<AigGateLit> piValue(numPI);
-	for(size_t i = 0, idx = 0, I = ntk->getInputNum(); i < I; ++i)
-		if(ntk->getInputNorm(i)->isGlobalRef())
-			piValue[idx++] = makeToLit(ntk->getInputID(i), !solver->getValueBool(ntk->getInputID(i), 0));
 
 	solver->clearAssump();
 	solver->addAssump(act, false);
-	for(unsigned i = 0; i < numPI; ++i)
-		solver->addAssump(piValue[i], 0);
-	for(AigGateLit lit: genCube)
-		solver->addAssump(lit, 0);
-	bool result = satSolve();
+	addAssumps();
+	result = solver->solve();
 	assert(!result);
-	if(result)
-		{ cerr << "[Error] The previous terSim is wrong!" << endl; return; }
-	size_t s = 0, n = genCube.size();
-	for(size_t i = 0; i < n; ++i)
-		if(solver->inConflict(getGateID(genCube[i])))
-			genCube[s++] = genCube[i];
-	// TODO
+	size_t s = 0;
+	for(size_t i = 0, n = cube.size(); i < n; ++i)
+		if(solver->inConflict(getGateID(cube[i]), 0))
+			cube[s++] = cube[i];
+	cube.resize(s);
 
-	disableActVar(act);
+	// Drop the clauses of the used activation variables once in a while
+	solver->addClause(Lit(act, true));
+	if(++disabledNum == 1000)
+		{ solver->removeSatisfied(); disabledNum = 0; }
 }
 
 void
@@ -1829,11 +2571,19 @@ PdrChecker::genSimCand(const vector<AigGateID>& target)const
 	terSimSup.genDfsList(target);
 	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
 		if(AigGateID id = ntk->getLatchID(i); ntk->getGate(id)->isGlobalRef())
-			genCube.push_back(makeToLit(id, !solver->getValueBool(id, 0)));
+			genCube.push_back(makeToLit(id, !getLatchValue(i)));
 	if(isOrdDynamic())
 		sortGenCubeByAct();
 }
 
+bool
+PdrChecker::getModelValue(AigGateID id, size_t patRow)const
+{
+	if(patHit == MAX_SIZE_T)
+		return solver->getValueBool(id, 0);
+	return (pattern[patHit / 64][patRow] >> (patHit % 64)) & 1;
+}
+
 void
 PdrChecker::sortGenCubeByAct()const
 {
@@ -1866,6 +2616,58 @@ PdrChecker::addState(const PdrCube& c, size_t level)const
 		solver->addAssump(c.getLit(i), level);
 }
 
+void
+PdrChecker::selectSolver(size_t f)const
+{
+	if(!perFrameSolver)
+		return;
+	const size_t i = f < actVar.size() ? f : actVar.size() - 1;
+	if(i >= frameSolverList.size())
+		frameSolverList.resize(i + 1);
+	if(frameSolverList[i].s == 0)
+	{
+		// The clauses of frames before i are never activated, so only those of frame Inf are loaded now
+		frameSolverList[i].s = getSolver(ntk);
+		frameSolverList[i].s->setCutMap(cutMap);
+		switchSolver(i);
+		convertCNF();
+		frameConverted = actVar.size();
+		addBlockedCubeInf();
+	}
+	else switchSolver(i);
+}
+
+void
+PdrChecker::switchSolver(size_t i)const
+{
+	if(i != curSolverIdx)
+	{
+		PdrFrameSolver& cur = frameSolverList[curSolverIdx];
+		cur.actVar.swap(actVar);
+		cur.frameConverted = frameConverted;
+		PdrFrameSolver& next = frameSolverList[i];
+		actVar.swap(next.actVar);
+		frameConverted = next.frameConverted;
+		solver = next.s;
+		curSolverIdx = i;
+	}
+	while(actVar.size() < frame.size() - 1)
+		actVar.push_back(solver->newVar());
+}
+
+void
+PdrChecker::discardFrameSolvers(size_t from)const
+{
+	assert(from > 0);
+	if(frameSolverList.size() <= from)
+		return;
+	if(curSolverIdx >= from)
+		switchSolver(0);
+	for(size_t i = from; i < frameSolverList.size(); ++i)
+		delete frameSolverList[i].s;
+	frameSolverList.resize(from);
+}
+
 void
 PdrChecker::activateFrame(size_t f)const
 {
@@ -1881,25 +2683,32 @@ PdrChecker::activateFrame(size_t f)const
 
 PdrCube
 PdrChecker::unsatGen(const PdrCube& c)const
+{
+	unsatGen(c, solver, genCube);
+	return PdrCube(genCube);
+}
+
+void
+PdrChecker::unsatGen(const PdrCube& c, const CirSolver* s, vector<AigGateLit>& gen)const
 {
 	assert(!isInitial(c));
-	genCube.clear();
+	gen.clear();
 	switch(initType)
 	{
 		case PDR_INIT_DEFAULT:
 			for(unsigned i = 0; i < c.getSize(); ++i)
-				if(solver->inConflict(getGateID(c.getLit(i)), 1))
-					genCube.push_back(c.getLit(i));
-			if(isInitial(genCube))
+				if(s->inConflict(getGateID(c.getLit(i)), 1))
+					gen.push_back(c.getLit(i));
+			if(isInitial(gen))
 			{
 				for(unsigned i = c.getSize() - 1; i != MAX_UNSIGNED; --i)
 					if(!isInv(c.getLit(i)))
 					{
-						size_t j = genCube.size();
-						genCube.emplace_back();
-						for(; j > 0 && c.getLit(i) < genCube[j-1]; --j)
-							genCube[j] = genCube[j-1];
-						genCube[j] = c.getLit(i);
+						size_t j = gen.size();
+						gen.emplace_back();
+						for(; j > 0 && c.getLit(i) < gen[j-1]; --j)
+							gen[j] = gen[j-1];
+						gen[j] = c.getLit(i);
 						break;
 					}
 			}
@@ -1907,39 +2716,38 @@ PdrChecker::unsatGen(const PdrCube& c)const
 
 		case PDR_INIT_CLAUSE:
 			for(unsigned i = 0; i < c.getSize(); ++i)
-				if(solver->inConflict(getGateID(c.getLit(i)), 1) || diffPolar(c.getLit(i)))
-					genCube.push_back(c.getLit(i));
+				if(s->inConflict(getGateID(c.getLit(i)), 1) || diffPolar(c.getLit(i)))
+					gen.push_back(c.getLit(i));
 			break;
 
 		case PDR_INIT_CUBE:
 			for(unsigned i = 0; i < c.getSize(); ++i)
-				if(solver->inConflict(getGateID(c.getLit(i)), 1))
-					genCube.push_back(c.getLit(i));
-			if(isInitial(genCube))
+				if(s->inConflict(getGateID(c.getLit(i)), 1))
+					gen.push_back(c.getLit(i));
+			if(isInitial(gen))
 			{
 				for(unsigned i = c.getSize() - 1; i != MAX_UNSIGNED; --i)
 					if(diffPolar(c.getLit(i)))
 					{
-						size_t j = genCube.size();
-						genCube.emplace_back();
-						for(; j > 0 && c.getLit(i) < genCube[j-1]; --j)
-							genCube[j] = genCube[j-1];
-						genCube[j] = c.getLit(i);
+						size_t j = gen.size();
+						gen.emplace_back();
+						for(; j > 0 && c.getLit(i) < gen[j-1]; --j)
+							gen[j] = gen[j-1];
+						gen[j] = c.getLit(i);
 						break;
 					}
 			}
 			break;
 	}
-	assert(!isInitial(genCube));
-	return PdrCube(genCube);
+	assert(!isInitial(gen));
 }
 
 size_t
-PdrChecker::findLowestActPlus1(size_t f)const
+PdrChecker::findLowestActPlus1(size_t f, const CirSolver* s, const vector<Var>& act)
 {
-	const size_t maxF = actVar.size();
+	const size_t maxF = act.size();
 	for(; f < maxF; ++f)
-		if(solver->inConflict(actVar[f]))
+		if(s->inConflict(act[f]))
 			return ++f == maxF ? f - 1 : f;
 	return FRAME_INF;
 }
@@ -2004,44 +2812,55 @@ PdrChecker::addNextState(const vector<AigGateLit>& cubeVec, size_t ignoreIdx)con
 			solver->addAssump(cubeVec[i], 1);
 }
 
+Var
+PdrChecker::setGenQuery(size_t f, size_t ignoreIdx)const
+{
+	selectSolver(f);
+	solver->clearAssump();
+	const Var act = addCurNotState(genCube, ignoreIdx);
+	activateFrame(f); //it's fine even if f is FRAME_NULL, i.e. newF is FRAME_INF
+	addNextState(genCube, ignoreIdx);
+	return act;
+}
+
 void
 PdrChecker::printCurFrames(const char* prefix)const
 {
 	if(isVerboseON(PDR_VERBOSE_CUBE))
-		cout << "/" << RepeatChar('*', 72) << "\\" << endl
-		     << "|" << RepeatChar('*', 72) << "|"  << endl;
+		sfcOut << "/" << RepeatChar('*', 72) << "\\" << endl
+		       << "|" << RepeatChar('*', 72) << "|"  << endl;
 
 	if(isVerboseON(PDR_VERBOSE_FRAME))
 	{
-		cout << prefix << curFrame << ":";
+		sfcOut << prefix << curFrame << ":";
 		size_t f = 0;
 		for(; f <= curFrame; ++f)
-			cout << " " << frame[f].size();
+			sfcOut << " " << frame[f].size();
 		if(f + 1 < frame.size())
 		{
-			cout << " |";
+			sfcOut << " |";
 			for(; f < frame.size() - 1; ++f)
-				cout << " " << frame[f].size();
-			cout << " |";
+				sfcOut << " " << frame[f].size();
+			sfcOut << " |";
 		}
-		cout << " " << frame.back().size() << endl;
+		sfcOut << " " << frame.back().size() << endl;
 	}
 
 	if(isVerboseON(PDR_VERBOSE_CUBE))
 	{
 		for(size_t f = 1, n = frame.size(); f < n; ++f)
 		{
-			cout << RepeatChar('*', 6) << endl;
-			cout << "Frame "; if(f == n - 1) cout << "Inf"; else cout << f; cout << endl;
-			cout << RepeatChar('*', 6) << endl;
+			sfcOut << RepeatChar('*', 6) << endl;
+			sfcOut << "Frame "; if(f == n - 1) sfcOut << "Inf"; else sfcOut << f; sfcOut << endl;
+			sfcOut << RepeatChar('*', 6) << endl;
 			if(frame[f].empty())
-				cout << "None" << endl;
+				sfcOut << "None" << endl;
 			else
 				for(size_t i = 0, nn = frame[f].size(); i < nn; ++i)
-					cout << "(" << (i + 1) << ") " << frame[f][i] << endl;
+					sfcOut << "(" << (i + 1) << ") " << frame[f][i] << endl;
 		}
-		cout << "|"  << RepeatChar('*', 72) << "|" << endl
-		     << "\\" << RepeatChar('*', 72) << "/" << endl;
+		sfcOut << "|"  << RepeatChar('*', 72) << "|" << endl
+		       << "\\" << RepeatChar('*', 72) << "/" << endl;
 	}
 }
 
@@ -2050,26 +2869,31 @@ PdrChecker::printRemainObl()const
 {
 	if(isVerboseON(PDR_VERBOSE_FRAME))
 	{
-		cout << "Remaining proof obligation:";
+		sfcOut << "Remaining proof obligation:";
 		for(const deque<PdrCube>& f: badDequeVec)
-			cout << " " << f.size();
-		cout << endl;
+			sfcOut << " " << f.size();
+		sfcOut << endl;
 	}
 }
 
 void
 PdrChecker::checkBreak(const char* funcName, bool blockNow)const
 {
+	// For parallel PDR, the helpers are stopped only through the shared store
+	if(sharedStore != 0 && sharedStore->isDone())
+		throw CheckerBreak();
+	if(threadIdx != 0)
+		return;
 	if(checkIsStopped())
 	{
-		cout << "\r";
+		sfcOut << "\r";
 		printCurFrames("Z ");
 		printStats();
 		const string wait = "Press any key to continue...";
-		cout << "\r" << wait;
+		sfcOut << "\r" << wait;
 		returnExactKey();
 		setToOld();
-		cout << CleanStrOnTerminal(wait.c_str()) << "\r" << flush;
+		sfcOut << CleanStrOnTerminal(wait.c_str()) << "\r" << flush;
 		resetStop();
 	}
 	if(checkBreakCond())
@@ -2094,6 +2918,7 @@ PdrChecker::satSolve()const
 {
 	satQueryTime += 1;
 	totalSatQuery += 1;
+	patHit = MAX_SIZE_T;
 	size_t d = solver->getDecisionNum();
 	size_t c = solver->getConflictNum();
 	if(satStat.isON())
@@ -2112,10 +2937,8 @@ PdrChecker::satSolve()const
 		satStat->incConfNum(c);
 	}
 	if(!isSAT) checkMaxD(d);
-	#ifdef UsePatternCheckSAT
-	assert(!simResult || isSAT);
-	if(isSAT) collectPattern();
-	#endif
+	if(isSAT && patBlockNum != 0)
+		collectPattern();
 	return isSAT;
 }
 
@@ -2124,6 +2947,7 @@ PdrChecker::satSolveLimited()const
 {
 	satQueryTime += 1;
 	totalSatQuery += 1;
+	patHit = MAX_SIZE_T;
 	size_t d = solver->getDecisionNum();
 	size_t c = solver->getConflictNum();
 	if(satStat.isON())
@@ -2148,10 +2972,8 @@ PdrChecker::satSolveLimited()const
 		satStat->incConfNum(c);
 	}
 	if(result == l_False) checkMaxD(d);
-	#ifdef UsePatternCheckSAT
-	assert(!simResult || result != l_False);
-	if(result == l_True) collectPattern();
-	#endif
+	if(result == l_True && patBlockNum != 0)
+		collectPattern();
 	return result != l_False;
 }
 
@@ -2173,6 +2995,20 @@ PdrChecker::checkRecycle()
 			recycleStat->startTime();
 		unusedVarNum = 0;
 		satQueryTime = 0;
+		// The per-frame solvers are rebuilt at their next queries
+		discardFrameSolvers(1);
+		if(recycleIncr)
+		{
+			// The disabled activation variables are false at the top level,
+			// so removing the satisfied clauses only drops the retired cubes,
+			// the temporary clauses and the learned clauses relying on them
+			const unsigned oriClsNum = solver->getClsNum();
+			solver->removeSatisfied();
+			if(recycleStat.isON())
+				recycleStat->incRemovedClsNum(oriClsNum - solver->getClsNum()),
+				recycleStat->finishTime();
+			return;
+		}
 		solver->resetSolver();
 		convertCNF();
 		for(Var& act: actVar)
@@ -2190,14 +3026,17 @@ PdrChecker::checkRecycle()
 void
 PdrChecker::convertCNF()const
 {
-	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
-		solver->convertToCNF(ntk->getLatchID(i), 0);
 	if(!convertInNeedCone)
 	{
-		for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
-			solver->convertToCNF(ntk->getLatchID(i), 1);
-		solver->convertToCNF(property, 0);
+		solver->loadCNF(getCnfTemplate(), 0);
+		if(mainType == PDR_MAIN_MULTI)
+			for(size_t i = 0, O = ntk->getOutputNum(); i < O; ++i)
+				solver->convertToCNF(ntk->getOutputID(i), 0, false);
+		else solver->convertToCNF(property, 0, false);
 	}
+	else
+		for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
+			solver->convertToCNF(ntk->getLatchID(i), 0);
 }
 
 
@@ -2257,9 +3096,9 @@ PdrChecker::refineInf()
 			{
 				assert(newCube.getSize() < c.getSize());
 				if(isVerboseON(PDR_VERBOSE_INF))
-					cout << RepeatChar('-', 36) << endl
-					     << "Further decrease " << (c.getSize() - newCube.getSize()) << " literals!" << endl
-					     << RepeatChar('-', 36) << endl;
+					sfcOut << RepeatChar('-', 36) << endl
+					       << "Further decrease " << (c.getSize() - newCube.getSize()) << " literals!" << endl
+					       << RepeatChar('-', 36) << endl;
 				if(propStat.isON())
 					propStat->incInfLitCount(c.getSize() - newCube.getSize());
 				addBlockedCube(newTCube);
@@ -2284,7 +3123,7 @@ PdrChecker::checkThenPushObl(size_t f, const PdrCube& c)
 				if(ret = selfSubsume(badDequeVec[f][i], c);
 				   ret == UNDEF_GATELIT)
 				{
-cout << "Subsume 2" << endl;
+sfcOut << "Subsume 2" << endl;
 					assert(s == i);
 					if(cubeStat.isON())
 						cubeStat->incSubsumeAddObl();
@@ -2295,29 +3134,56 @@ cout << "Subsume 2" << endl;
 				else if(ret != ERROR_GATELIT)
 				{}
 
-//cout << "None" << endl;
+//sfcOut << "None" << endl;
 				if(s < i)
 					badDequeVec[f][s++] = move(badDequeVec[f][i]);
 				else { assert(s == i); s += 1; }
 			}
 			else if(ret == UNDEF_GATELIT)
 			{
-cout << "Subsume" << endl;
+sfcOut << "Subsume" << endl;
+				badSetVec[f].erase(badDequeVec[f][i]);
 				if(cubeStat.isON())
 					cubeStat->incSubsumeAddObl();
 			}
 			else
 			{
-cout << "Self Subsume " << ret << endl;
+sfcOut << "Self Subsume " << ret << endl;
 				if(s < i)
 					badDequeVec[f][s++] = move(badDequeVec[f][i]);
 				else { assert(s == i); s += 1; }
 			}
 		badDequeVec[f].resize(s);
+		if(isDeqHeap())
+			make_heap(badDequeVec[f].begin(), badDequeVec[f].end(),
+			          [this](const PdrCube& c1, const PdrCube& c2) { return isLowerPriority(c1, c2); });
 	}
 	if(keep)
 	{
-		if(sortByBadDepth)
+		if(cubeStat.isON())
+			cubeStat->incPushOblNum();
+		if(!badSetVec[f].insert(c).second)
+		{
+			if(cubeStat.isON())
+				cubeStat->incDupOblNum();
+			return;
+		}
+		if(isDeqHeap())
+		{
+			badDequeVec[f].push_back(c);
+			if(deqType == PDR_DEQ_ACTIVITY)
+			{
+				if(badHeapStamp.size() <= f)
+					badHeapStamp.resize(f + 1, MAX_SIZE_T);
+				// A stale heap is rebuilt on the next access anyway
+				if(badHeapStamp[f] == actBumpNum)
+					push_heap(badDequeVec[f].begin(), badDequeVec[f].end(),
+					          [this](const PdrCube& c1, const PdrCube& c2) { return isLowerPriority(c1, c2); });
+			}
+			else push_heap(badDequeVec[f].begin(), badDequeVec[f].end(),
+			               [this](const PdrCube& c1, const PdrCube& c2) { return isLowerPriority(c1, c2); });
+		}
+		else if(sortByBadDepth)
 		{
 			size_t s = badDequeVec[f].size();
 			badDequeVec[f].emplace_back();
@@ -2330,10 +3196,119 @@ cout << "Self Subsume " << ret << endl;
 		}
 		else badDequeVec[f].push_back(c);
 	}
+	assert(badSetVec[f].size() == badDequeVec[f].size());
 	if(cubeStat.isON())
 		cubeStat->checkMaxBNum(badDequeVec[f].size());
 }
 
+/*
+	With a heap policy, the deque of each frame is kept as a binary heap whose front is the next bad cube
+	The frames are still checked from the lowest one, so the policy only orders the cubes within a frame
+	The activity of literals grows whenever a cube is blocked, so the heap ordered by activity
+	is rebuilt before taking its top if any cube has been blocked since the last rebuild,
+	and otherwise it is kept by push_heap and pop_heap like the other heap policies
+*/
+const PdrCube&
+PdrChecker::getBadCube(size_t f)
+{
+	deque<PdrCube>& badDeque = badDequeVec[f];
+	assert(!badDeque.empty());
+	switch(deqType)
+	{
+		case PDR_DEQ_STACK : return badDeque.back();
+		case PDR_DEQ_QUEUE : return badDeque.front();
+		case PDR_DEQ_ACTIVITY:
+			if(badHeapStamp.size() <= f)
+				badHeapStamp.resize(f + 1, MAX_SIZE_T);
+			if(badHeapStamp[f] != actBumpNum)
+			{
+				make_heap(badDeque.begin(), badDeque.end(),
+				          [this](const PdrCube& c1, const PdrCube& c2) { return isLowerPriority(c1, c2); });
+				badHeapStamp[f] = actBumpNum;
+			}
+			return badDeque.front();
+		default: return badDeque.front();
+	}
+}
+
+void
+PdrChecker::popBadCube(size_t f)
+{
+	deque<PdrCube>& badDeque = badDequeVec[f];
+	assert(!badDeque.empty());
+	switch(deqType)
+	{
+		case PDR_DEQ_STACK:
+			badSetVec[f].erase(badDeque.back());
+			badDeque.pop_back();
+			break;
+		case PDR_DEQ_QUEUE:
+			badSetVec[f].erase(badDeque.front());
+			badDeque.pop_front();
+			break;
+		case PDR_DEQ_ACTIVITY:
+			badSetVec[f].erase(badDeque.front());
+			// The keys may have changed after getting the top, and then the heap is rebuilt on the next access
+			if(badHeapStamp[f] == actBumpNum)
+				pop_heap(badDeque.begin(), badDeque.end(),
+				         [this](const PdrCube& c1, const PdrCube& c2) { return isLowerPriority(c1, c2); });
+			else if(badDeque.size() > 1)
+				badDeque.front() = move(badDeque.back());
+			badDeque.pop_back();
+			break;
+		default:
+			badSetVec[f].erase(badDeque.front());
+			pop_heap(badDeque.begin(), badDeque.end(),
+			         [this](const PdrCube& c1, const PdrCube& c2) { return isLowerPriority(c1, c2); });
+			badDeque.pop_back();
+			break;
+	}
+}
+
+void
+PdrChecker::clearObl()
+{
+	for(deque<PdrCube>& badDeque: badDequeVec)
+		badDeque.clear();
+	for(PdrCubeSet& badSet: badSetVec)
+		badSet.clear();
+	badHeapStamp.clear();
+}
+
+bool
+PdrChecker::isLowerPriority(const PdrCube& c1, const PdrCube& c2)const
+{
+	switch(deqType)
+	{
+		case PDR_DEQ_SMALL:
+			if(c1.getSize() != c2.getSize())
+				return c1.getSize() > c2.getSize();
+			return c1.getBadDepth() < c2.getBadDepth();
+		case PDR_DEQ_DEPTH:
+			if(c1.getBadDepth() != c2.getBadDepth())
+				return c1.getBadDepth() < c2.getBadDepth();
+			return c1.getSize() > c2.getSize();
+		case PDR_DEQ_ACTIVITY:
+			if(const double a1 = getOblActivity(c1), a2 = getOblActivity(c2); a1 != a2)
+				return a1 < a2;
+			return c1.getSize() > c2.getSize();
+		default:
+			assert(false);
+			return false;
+	}
+}
+
+double
+PdrChecker::getOblActivity(const PdrCube& c)const
+{
+	if(c.getSize() == 0)
+		return 0.0;
+	double act = 0.0;
+	for(unsigned i = 0; i < c.getSize(); ++i)
+		act += activity[getGateID(c.getLit(i))];
+	return act / c.getSize();
+}
+
 void
 PdrChecker::checkAndPrintIndInv()
 {
@@ -2343,9 +3318,9 @@ PdrChecker::checkAndPrintIndInv()
 	vector<PdrCube> indInv = getCurIndSet(true);
 	if(checkIndInv)
 	{
-		cout << RepeatChar('=', 36) << endl
-		     << "Check the inductive invariant:" << endl;
-		SolverPtr<CirSolver> checkSolver(ntk);
+		sfcOut << RepeatChar('=', 36) << endl
+		       << "Check the inductive invariant:" << endl;
+		SolverPtr<CirSolver> checkSolver(ntk, cutMap);
 
 		Progresser initP("1. Check if the initial state is in the set : ", indInv.size());
 		for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
@@ -2392,17 +3367,17 @@ PdrChecker::checkAndPrintIndInv()
 			initP.count();
 		}
 		initP.cleanCurLine();
-		cout << "\r1. Check if the initial state is in the set : "
-		     << (notInit.empty() ? "PASS" : "FAIL") << endl;
+		sfcOut << "\r1. Check if the initial state is in the set : "
+		       << (notInit.empty() ? "PASS" : "FAIL") << endl;
 		if(!notInit.empty())
 		{
-			cout << "Failed clause:" << endl;
+			sfcOut << "Failed clause:" << endl;
 			for(const PdrCube& c: notInit)
-				cout << c << endl;
+				sfcOut << c << endl;
 		}
 		checkSolver->addClause(initAct);
 
-		cout << "2. Check if the property holds for the set  : " << flush;
+		sfcOut << "2. Check if the property holds for the set  : " << flush;
 		for(const PdrCube& c: indInv)
 		{
 			for(unsigned i = 0; i < c.getSize(); ++i)
@@ -2413,12 +3388,12 @@ PdrChecker::checkAndPrintIndInv()
 		}
 		checkSolver->clearAssump();
 		if(targetCube.isNone())
-			checkSolver->convertToCNF(property, 0),
+			checkSolver->convertToCNF(property, 0, false),
 			checkSolver->addAssump(property, 0, false);
 		else
 			for(AigGateLit lit: targetCube)
 				checkSolver->addAssump(lit, 0);
-		cout << (checkSolver->solve() ? "FAIL" : "PASS") << endl;
+		sfcOut << (checkSolver->solve() ? "FAIL" : "PASS") << endl;
 
 		Progresser indP("3. Check if the set itself is inductive: ", indInv.size());
 		indP.printLine();
@@ -2434,27 +3409,27 @@ PdrChecker::checkAndPrintIndInv()
 			indP.count();
 		}
 		indP.cleanCurLine();
-		cout << "\r3. Check if the set itself is inductive     : "
-		     << (notInd.empty() ? "PASS" : "FAIL") << endl;
+		sfcOut << "\r3. Check if the set itself is inductive     : "
+		       << (notInd.empty() ? "PASS" : "FAIL") << endl;
 		if(!notInd.empty())
 		{
-			cout << "Failed clause:" << endl;
+			sfcOut << "Failed clause:" << endl;
 			for(const PdrCube& c: notInd)
-				cout << c << endl;
+				sfcOut << c << endl;
 		}
 	}
 
 	if(isVerboseON(PDR_VERBOSE_FINAL))
 	{
-		cout << "/" << RepeatChar('*', 72) << "\\" << endl
-		     << "|" << RepeatChar('*', 72) << "|"  << endl;
+		sfcOut << "/" << RepeatChar('*', 72) << "\\" << endl
+		       << "|" << RepeatChar('*', 72) << "|"  << endl;
 		if(indInv.empty())
-			cout << "Tautology" << endl;
+			sfcOut << "Tautology" << endl;
 		else
 			for(size_t i = 0, n = indInv.size(); i < n; ++i)
-				cout << "(" << i + 1 << ") " << indInv[i] << endl;
-		cout << "|"  << RepeatChar('*', 72) << "|" << endl
-		     << "\\" << RepeatChar('*', 72) << "/" << endl;
+				sfcOut << "(" << i + 1 << ") " << indInv[i] << endl;
+		sfcOut << "|"  << RepeatChar('*', 72) << "|" << endl
+		       << "\\" << RepeatChar('*', 72) << "/" << endl;
 	}
 }
 
@@ -2516,31 +3491,54 @@ PdrChecker::pushToFrameInf(size_t emptyFrame)
 			{
 				if(isVerboseON(PDR_VERBOSE_PROP))
 				{
-					cout << RepeatChar('-', 36) << endl
-					     << "Propagate cube by induction from frame " << ff << " to Inf"
-					     << ":" << c            << endl
-					     << RepeatChar('-', 36) << endl;
+					sfcOut << RepeatChar('-', 36) << endl
+					       << "Propagate cube by induction from frame " << ff << " to Inf"
+					       << ":" << c            << endl
+					       << RepeatChar('-', 36) << endl;
 				}
 				addBlockedCube(PdrTCube(FRAME_INF, c), inf);
 				if(propStat.isON())
 					propStat->incInfCubeCount();
 			}
 		frame[ff].clear();
+		invalidateIndex(ff);
 	}
+	// The frames after the empty one are merged into frame Inf, so are their solvers
+	discardFrameSolvers(emptyFrame + 1);
 	for(; emptyFrame < inf; ++emptyFrame)
 		assert(frame[emptyFrame].empty());
 }
 
+bool
+PdrChecker::isSubsumedInFrame(const PdrCube& cube, size_t f)const
+{
+	getFrameIndex(f).getSubsumerCand(cube, candList);
+	if(cubeStat.isON())
+		cubeStat->incScanCubeNum(frame[f].size()),
+		cubeStat->incCandCubeNum(candList.size());
+	for(unsigned i: candList)
+		if(subsume(frame[f][i], cube))
+			return true;
+	return false;
+}
+
+const PdrFrameIndex&
+PdrChecker::getFrameIndex(size_t f)const
+{
+	// Rebuild lazily if the frame is modified other than appending by addBlockedCube
+	if(!frameIndex[f].isValid(frame[f].size()))
+		frameIndex[f].build(frame[f]);
+	return frameIndex[f];
+}
+
 bool
 PdrChecker::checkIsSubsumed(const PdrCube& cube, size_t startFrame, size_t endFrame)const
 {
 	if(cubeStat.isON())
 		cubeStat->startTime();
 	bool ret = false;
-	for(size_t f = startFrame; f <= endFrame; ++f)
-		for(size_t i = 0, n = frame[f].size(); i < n; ++i)
-			if(subsume(frame[f][i], cube))
-				{ ret = true; break; }
+	for(size_t f = startFrame; f <= endFrame && !ret; ++f)
+		ret = isSubsumedInFrame(cube, f);
 	if(cubeStat.isON())
 		cubeStat->finishTime();
 	return ret;
@@ -2553,24 +3551,34 @@ PdrChecker::checkSubsumeOthers(const PdrCube& cube, size_t startFrame, size_t en
 		cubeStat->startTime();
 	for(size_t f = startFrame; f <= endFrame; ++f)
 	{
-		size_t s = 0;
-		for(size_t i = 0, n = frame[f].size(); i < n; ++i)
+		getFrameIndex(f).getSubsumedCand(cube, candList);
+		if(cubeStat.isON())
+			cubeStat->incScanCubeNum(frame[f].size()),
+			cubeStat->incCandCubeNum(candList.size());
+		bool removed = false;
+		for(unsigned i: candList)
 		{
 			assert(!frame[f][i].getMarkA());
-			if(!subsume(cube, frame[f][i]))
-			{
-				if(s < i)
-					frame[f][s++] = move(frame[f][i]);
-				else { assert(s == i); s += 1; }
-			}
-			else
+			if(subsume(cube, frame[f][i]))
 			{
 				frame[f][i].setMarkA(true);
+				removed = true;
 				if(cubeStat.isON())
 					cubeStat->incSubsumeBlockCube();
 			}
 		}
+		if(!removed)
+			continue;
+		size_t s = 0;
+		for(size_t i = 0, n = frame[f].size(); i < n; ++i)
+			if(!frame[f][i].getMarkA())
+			{
+				if(s < i)
+					frame[f][s++] = move(frame[f][i]);
+				else { assert(s == i); s += 1; }
+			}
 		frame[f].resize(s);
+		invalidateIndex(f);
 	}
 	if(cubeStat.isON())
 		cubeStat->finishTime();
@@ -2595,7 +3603,7 @@ PdrChecker::printTrace()const
 			cexTrace.push_back(prev);
 		}
 
-		SolverPtr<CirSolver> traceSolver(ntk);
+		SolverPtr<CirSolver> traceSolver(ntk, cutMap);
 		const size_t L = ntk->getLatchNum();
 		Array<bool> curState(L);
 		for(size_t i = 0; i < L; ++i)
@@ -2626,7 +3634,7 @@ PdrChecker::printTrace()const
 			assert(result);
 			if(!result)
 				{ cerr << "[Error] The trace cannot be connected! The proof goes wrong!" << endl; return; }
-			traceSolver->reportPI(c-1, 0);
+			traceSolver->reportPI(sfcOut, c-1, 0);
 			traceSolver->clearAssump();
 			for(size_t i = 0; i < L; ++i)
 				curState[i] = !(traceSolver->getValueBool(ntk->getLatchID(i), 1));
@@ -2635,7 +3643,7 @@ PdrChecker::printTrace()const
 		for(size_t i = 0; i < L; ++i)
 			traceSolver->addAssump(ntk->getLatchID(i), 0, curState[i]);
 		if(targetCube.isNone())
-			traceSolver->convertToCNF(property, 0),
+			traceSolver->convertToCNF(property, 0, false),
 			traceSolver->addAssump(property, 0, false);
 		else
 			for(AigGateLit lit: targetCube)
@@ -2644,7 +3652,7 @@ PdrChecker::printTrace()const
 		assert(result);
 		if(!result)
 			{ cerr << "[Error] The trace cannot be connected! The proof goes wrong!" << endl; return; }
-		traceSolver->reportPI(cexTrace.size()-1, 0);
+		traceSolver->reportPI(sfcOut, cexTrace.size()-1, 0);
 	}
 }
 
@@ -2661,6 +3669,7 @@ PdrChecker::collectInd()
 			checkSubsumeOthers(c, infFrame, infFrame);
 			frame[infFrame].push_back(c);
 		}
+	invalidateIndex(infFrame);
 }
 
 void
@@ -2727,11 +3736,11 @@ void
 PdrChecker::printStats()const
 {
 	if(terSimStat.isON())
-		terSimStat->printStat();
+		terSimStat->printStat(simType == PDR_SIM_LIFT);
 	if(satStat.isON())
-		satStat->printStat(genType == PDR_GEN_APPROX);
+		satStat->printStat(genType == PDR_GEN_APPROX, patBlockNum != 0);
 	if(unsatGenStat.isON())
-		unsatGenStat->printStat();
+		unsatGenStat->printStat(genType == PDR_GEN_CTG);
 	if(propStat.isON())
 		propStat->printStat();
 	if(recycleStat.isON())
@@ -2739,14 +3748,6 @@ PdrChecker::printStats()const
 	if(cubeStat.isON())
 		cubeStat->printStat();
 
-	#ifdef UsePatternCheckSAT
-	sfcMsg << RepeatChar('=', 36) << endl
-	       << "matchTry   = " << matchTry   << endl
-	       << "matchFrame = " << matchFrame << endl
-	       << "matchSAT   = " << matchSAT   << endl
-	       << "matchTime  = " << (double(matchTime) / CLOCKS_PER_SEC) << endl;
-	#endif
-
 	if(clsStimulator != 0)
 		clsStimulator->printStats();
 	if(oblStimulator != 0)
@@ -2769,132 +3770,81 @@ PdrChecker::printStats()const
 	#endif
 }
 
-#ifdef UsePatternCheckSAT
-}
-#include <fstream>
-using namespace std;
-
-namespace _54ff
+/*
+	The frames only contain the clauses on the latches, so whether a stored state satisfies a query is decided
+	by checking the clauses of the frames and simulating the cone of the next state, 64 states at a time
+	Any assignment of the inputs and the latches is a valid solution once it passes the check,
+	so the stored states need not be reachable, and the filter never turns an UNSAT query into SAT
+*/
+bool
+PdrChecker::checkPatForSat(size_t f, const AigGateLit* lits, size_t n, size_t ignoreIdx, bool notCur)const
 {
-ofstream outFile("stat.out");
+	if(pattern.empty())
+		return false;
+	if(satStat.isON())
+		satStat->incFilterNum(),
+		satStat->startTime();
+	// A cube is never empty, so no literal means the query of the property
+	dfsList.clear();
+	AigGate::setGlobalRef();
+	if(n == 0)
+		ntk->getGate(property)->getFanIn0Ptr()->genDfsList(dfsList);
+	else
+		for(size_t i = 0; i < n; ++i)
+			if(i != ignoreIdx)
+				ntk->getGate(getGateID(lits[i]))->getFanIn0Ptr()->genDfsList(dfsList);
 
-void
-PdrChecker::checkPatForSat(size_t f, const PdrCube& cube)const
-{
-	clock_t t = clock();
-	if(isVerboseON(PDR_VERBOSE_MISC))
-		cout << RepeatChar('-', 36) << endl
-		     << "Check pattern (cube): frame = " << f << ", " << cube << endl
-		     << RepeatChar('-', 36) << endl;
-	genDfsList(cube);
-	static_assert(size_t(0xFFFFFFFFFFFFFFFF) == size_t(-1));
-//	for(size_t i = 0; i < pattern.size(); ++i)
-	for(size_t i = pattern.size() - 1; i != size_t(-1); --i)
+	// The latest block goes first since its states are close to the current frames
+	patHit = MAX_SIZE_T;
+	for(size_t k = 0, P = pattern.size(); k < P; ++k)
 	{
-		matchTry += 1;
-		simResult = false;
-		simMask = size_t(-1);
-		setPattern(i);
+		const size_t p = (patBlock + P - k) % P;
+		setPattern(p);
+		simMask = MAX_SIZE_T;
 		checkPatFrame(f);
+		if(notCur && simMask != 0)
+		{
+			size_t value = 0;
+			for(size_t i = 0; i < n; ++i)
+				if(i != ignoreIdx)
+					value |= isInv(lits[i]) ? simValue[getGateID(lits[i])] : ~simValue[getGateID(lits[i])];
+			simMask &= value;
+		}
 		if(simMask == 0)
 			continue;
-		size_t value = 0;
-		for(AigGateLit lit: cube)
-			value |= isInv(lit) ? simValue[getGateID(lit)] : ~simValue[getGateID(lit)];
-		simMask &= value;
-		if(simMask == 0)
-			continue;
-		matchFrame += 1;
 		simAllAnd();
-		value = size_t(-1);
-		for(AigGateLit lit: cube)
+		if(n == 0)
 		{
-			AigGate* g = ntk->getGate(getGateID(lit));
-			assert(g->getGateType() == AIG_LATCH);
-			value &= isInv(lit) ^ g->isFanIn0Inv() ? ~simValue[g->getFanIn0ID()]
-				                                   :  simValue[g->getFanIn0ID()];
+			const AigGate* g = ntk->getGate(property);
+			simMask &= g->isFanIn0Inv() ? ~simValue[g->getFanIn0ID()] : simValue[g->getFanIn0ID()];
 		}
-		if(simMask & value)
-			{ matchSAT += 1; simResult = true; matchTime += (clock() - t); outFile << pattern.size() - i << endl; return; }
+		else
+			for(size_t i = 0; i < n && simMask != 0; ++i)
+				if(i != ignoreIdx)
+				{
+					const AigGate* g = ntk->getGate(getGateID(lits[i]));
+					assert(g->getGateType() == AIG_LATCH);
+					simMask &= isInv(lits[i]) ^ g->isFanIn0Inv() ? ~simValue[g->getFanIn0ID()]
+					                                             :  simValue[g->getFanIn0ID()];
+				}
+		if(simMask != 0)
+			{ patHit = p * 64 + __builtin_ctzll(simMask); break; }
 	}
-	matchTime += (clock() - t);
-	outFile << -1 << endl;
-}
 
-void
-PdrChecker::checkPatForSat(size_t f, size_t ignoreIdx)const
-{
-	clock_t t = clock();
-	if(isVerboseON(PDR_VERBOSE_MISC))
-		cout << RepeatChar('-', 36) << endl
-		     << "Check pattern (genCube): frame = " << f << endl
-		     << RepeatChar('-', 36) << endl;
-	genDfsList(ignoreIdx);
-//	for(size_t i = 0; i < pattern.size(); ++i)
-	for(size_t i = pattern.size() - 1; i != size_t(-1); --i)
+	if(satStat.isON())
 	{
-		matchTry += 1;
-		simResult = false;
-		simMask = size_t(-1);
-		setPattern(i);
-		checkPatFrame(f);
-		if(simMask == 0)
-			continue;
-		size_t value = 0;
-		for(size_t i = 0; i < genCube.size(); ++i)
-			if(i != ignoreIdx)
-				value |= isInv(genCube[i]) ?  simValue[getGateID(genCube[i])]
-				                           : ~simValue[getGateID(genCube[i])];
-		simMask &= value;
-		if(simMask == 0)
-			continue;
-		matchFrame += 1;
-		simAllAnd();
-		value = size_t(-1);
-		for(size_t i = 0; i < genCube.size(); ++i)
-			if(i != ignoreIdx)
-			{
-				AigGate* g = ntk->getGate(getGateID(genCube[i]));
-				assert(g->getGateType() == AIG_LATCH);
-				value &= isInv(genCube[i]) ^ g->isFanIn0Inv() ? ~simValue[g->getFanIn0ID()]
-				                                              :  simValue[g->getFanIn0ID()];
-			}
-		if(simMask & value)
-			{ matchSAT += 1; simResult = true; matchTime += (clock() - t); outFile << pattern.size() - i << endl; return; }
+		satStat->finishFilterTime();
+		if(patHit != MAX_SIZE_T)
+			satStat->incFilterHit();
 	}
-	matchTime += (clock() - t);
-	outFile << -1 << endl;
-}
-
-void
-PdrChecker::checkPatForSat(size_t f)const
-{
-	clock_t t = clock();
-	if(isVerboseON(PDR_VERBOSE_MISC))
-		cout << RepeatChar('-', 36) << endl
-		     << "Check pattern (property): frame = " << f << endl
-		     << RepeatChar('-', 36) << endl;
-	genDfsList();
-//	for(size_t i = 0; i < pattern.size(); ++i)
-	for(size_t i = pattern.size() - 1; i != size_t(-1); --i)
+	if(patHit != MAX_SIZE_T && isVerboseON(PDR_VERBOSE_MISC))
 	{
-		matchTry += 1;
-		simResult = false;
-		simMask = size_t(-1);
-		setPattern(i);
-		checkPatFrame(f);
-		if(simMask == 0)
-			continue;
-		matchFrame += 1;
-		simAllAnd();
-		AigGate* p = ntk->getGate(property);
-		simValue[property] = p->isFanIn0Inv() ? ~simValue[p->getFanIn0ID()]
-		                                      :  simValue[p->getFanIn0ID()];
-		if(simMask & simValue[property])
-			{ matchSAT += 1; simResult = true; matchTime += (clock() - t); outFile << pattern.size() - i << endl; return; }
+		sfcOut << RepeatChar('-', 36) << endl
+		       << "Filter SAT query by simulation: frame = ";
+		if(f >= frame.size() - 1) sfcOut << "Inf"; else sfcOut << f;
+		sfcOut << endl << RepeatChar('-', 36) << endl;
 	}
-	matchTime += (clock() - t);
-	outFile << -1 << endl;
+	return patHit != MAX_SIZE_T;
 }
 
 void
@@ -2904,70 +3854,53 @@ PdrChecker::checkPatFrame(size_t f)const
 		f = frame.size() - 1;
 	if(f == 0)
 	{
-		for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i)
+		size_t value = 0;
+		for(size_t i = 0, L = ntk->getLatchNum(); i < L && simMask != 0; ++i)
 		{
-			simMask &= ~simValue[ntk->getLatchID(i)];
-			if(simMask == 0)
-				return;
+			const AigGateID id = ntk->getLatchID(i);
+			switch(initType)
+			{
+				case PDR_INIT_DEFAULT:
+					simMask &= ~simValue[id];
+					break;
+
+				case PDR_INIT_CLAUSE:
+					if(ThreeValue v = getInitValue(id); v != ThreeValue_DC)
+						value |= v == ThreeValue_True ? simValue[id] : ~simValue[id];
+					break;
+
+				case PDR_INIT_CUBE:
+					if(ThreeValue v = getInitValue(id); v != ThreeValue_DC)
+						simMask &= v == ThreeValue_True ? simValue[id] : ~simValue[id];
+					break;
+			}
 		}
+		if(initType == PDR_INIT_CLAUSE)
+			simMask &= value;
 		f += 1;
 	}
-	for(; f < frame.size(); ++f)
+	for(; f < frame.size() && simMask != 0; ++f)
 		for(const PdrCube& c: frame[f])
 		{
 			size_t value = 0;
-/*
 			for(AigGateLit lit: c)
-			{
-				assert(ntk->getGate(getGateID(lit))->getGateType() == AIG_LATCH);
 				value |= isInv(lit) ? simValue[getGateID(lit)] : ~simValue[getGateID(lit)];
-			}
-*/
-			for(unsigned i = 0; i < c.getSize(); ++i)
-				value |= isInv(c.getLit(i)) ?  simValue[getGateID(c.getLit(i))]
-				                            : ~simValue[getGateID(c.getLit(i))];
-			simMask &= value;
-			if(simMask == 0)
+			if((simMask &= value) == 0)
 				return;
 		}
 }
 
-void
-PdrChecker::genDfsList(const PdrCube& cube)const
-{
-	dfsList.clear();
-	AigGate::setGlobalRef();
-	for(unsigned i = 0; i < cube.getSize(); ++i)
-		ntk->getGate(getGateID(cube.getLit(i)))->getFanIn0Ptr()->genDfsList(dfsList);
-}
-
-void
-PdrChecker::genDfsList(size_t ignoreIdx)const
-{
-	dfsList.clear();
-	AigGate::setGlobalRef();
-	for(size_t i = 0; i < genCube.size(); ++i)
-		if(i != ignoreIdx)
-			ntk->getGate(getGateID(genCube[i]))->getFanIn0Ptr()->genDfsList(dfsList);
-}
-
-void
-PdrChecker::genDfsList()const
-{
-	dfsList.clear();
-	AigGate::setGlobalRef();
-	ntk->getGate(property)->getFanIn0Ptr()->genDfsList(dfsList);
-}
-
 void
 PdrChecker::simAllAnd()const
 {
-	for(AigAnd* a: dfsList)
+	const AigFlatView& view = ntk->getFlatView();
+	for(AigGateID id: dfsList)
 	{
-		simValue[a->getGateID()]  = a->isFanIn0Inv() ? ~simValue[a->getFanIn0ID()]
-		                                             :  simValue[a->getFanIn0ID()];
-		simValue[a->getGateID()] &= a->isFanIn1Inv() ? ~simValue[a->getFanIn1ID()]
-		                                             :  simValue[a->getFanIn1ID()];
+		const AigGateLit in0 = view.getFanIn0(id), in1 = view.getFanIn1(id);
+		simValue[id]  = isInv(in0) ? ~simValue[getGateID(in0)]
+		                           :  simValue[getGateID(in0)];
+		simValue[id] &= isInv(in1) ? ~simValue[getGateID(in1)]
+		                           :  simValue[getGateID(in1)];
 	}
 }
 
@@ -2984,26 +3917,32 @@ PdrChecker::setPattern(size_t p)const
 void
 PdrChecker::collectPattern()const
 {
+	const size_t I = ntk->getInputNum(), L = ntk->getLatchNum();
+	// The oldest block is overwritten once the ring is full, whose remaining states are still valid to simulate
 	if(patIdx == 64)
-		{ pattern.emplace_back(ntk->getInputNum() + ntk->getLatchNum()); patIdx = 0; }
+	{
+		if(pattern.size() < patBlockNum)
+			patBlock = pattern.size(),
+			pattern.emplace_back(I + L);
+		else patBlock = (patBlock + 1) % patBlockNum;
+		patIdx = 0;
+	}
+	Array<size_t>& block = pattern[patBlock];
 	size_t idx = 0;
-	for(size_t i = 0, I = ntk->getInputNum(); i < I; ++i, ++idx)
+	for(size_t i = 0; i < I; ++i, ++idx)
 	{
-		pattern.back()[idx] <<= 1;
-		assert((pattern.back()[idx] & 1) == 0);
+		block[idx] <<= 1;
 		if(solver->isConverted(ntk->getInputID(i), 0))
-			pattern.back()[idx] |= size_t(solver->getValueBool(ntk->getInputID(i), 0));
+			block[idx] |= size_t(solver->getValueBool(ntk->getInputID(i), 0));
 	}
-	for(size_t i = 0, L = ntk->getLatchNum(); i < L; ++i, ++idx)
+	for(size_t i = 0; i < L; ++i, ++idx)
 	{
-		pattern.back()[idx] <<= 1;
-		assert((pattern.back()[idx] & 1) == 0);
+		block[idx] <<= 1;
 		if(solver->isConverted(ntk->getLatchID(i), 0))
-			pattern.back()[idx] |= size_t(solver->getValueBool(ntk->getLatchID(i), 0));
+			block[idx] |= size_t(solver->getValueBool(ntk->getLatchID(i), 0));
 	}
 	patIdx += 1;
 }
-#endif
 
 #ifdef CheckOblCommonPart
 void
@@ -3019,7 +3958,7 @@ PdrChecker::checkInfCommonPart(const PdrTCube& tc)const
 	if(tc.getFrame() != FRAME_INF)
 		return;
 	const PdrCube& c = tc.getCube();
-//	cout << "Inf " << c << endl;
+//	sfcOut << "Inf " << c << endl;
 	if(++numInf == 1)
 	{
 		assert(commonPartInf.empty());
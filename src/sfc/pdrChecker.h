@@ -8,14 +8,17 @@
 #define HEHE_PDRCHECKER_H
 
 #include <deque>
+#include <unordered_set>
+#include <mutex>
+#include <atomic>
 #include "sfcChecker.h"
 #include "cirSolver.h"
 #include "aigMisc1.h"
 #include "stat.h"
 #include "alg.h"
+#include "slabAlloc.h"
 using namespace std;
 
-//#define UsePatternCheckSAT
 //#define CheckOblCommonPart
 
 namespace _54ff
@@ -26,7 +29,8 @@ enum PdrSimType
 	PDR_SIM_FORWARD_NORMAL,
 	PDR_SIM_FORWARD_EVENT,
 	PDR_SIM_BACKWARD_NORMAL,
-	PDR_SIM_BACKWARD_INTERNAL
+	PDR_SIM_BACKWARD_INTERNAL,
+	PDR_SIM_LIFT
 };
 
 enum PdrOrdType
@@ -48,7 +52,10 @@ enum PdrOblType
 enum PdrDeqType
 {
 	PDR_DEQ_STACK,
-	PDR_DEQ_QUEUE
+	PDR_DEQ_QUEUE,
+	PDR_DEQ_SMALL,
+	PDR_DEQ_DEPTH,
+	PDR_DEQ_ACTIVITY
 };
 
 enum PdrPrpType
@@ -61,7 +68,8 @@ enum PdrGenType
 {
 	PDR_GEN_NORMAL,
 	PDR_GEN_APPROX,
-	PDR_GEN_IGNORE
+	PDR_GEN_IGNORE,
+	PDR_GEN_CTG
 };
 
 enum PdrStatType
@@ -136,7 +144,8 @@ enum PdrShareType
 enum PdrMainType
 {
 	PDR_MAIN_NORMAL,
-	PDR_MAIN_ONE_BY_ONE
+	PDR_MAIN_ONE_BY_ONE,
+	PDR_MAIN_MULTI
 };
 
 enum PdrInitType
@@ -152,14 +161,14 @@ public:
 	void incLitCount   (size_t n) { countN(1, n); }
 	void incRemoveCount(size_t n) { countN(2, n); }
 
-	void printStat()const;
+	void printStat(bool)const;
 };
 
-class PdrSatStat : public Stat<5, 4>
+class PdrSatStat : public Stat<7, 5>
 {
 public:
 	PdrSatStat()
-	: Stat<5, 4> ()
+	: Stat<7, 5> ()
 	, minSAT_D   (-1)
 	, maxUNSAT_D (0)
 	, maxAbort_D (0) {}
@@ -167,8 +176,11 @@ public:
 	void setLastTime() { setTime(3); }
 	void incDeciNum(size_t n) { countN(3, n); }
 	void incConfNum(size_t n) { countN(4, n); }
+	void incFilterNum() { countOne(5); }
+	void incFilterHit() { countOne(6); }
+	void finishFilterTime() { finishTime(4); }
 
-	void printStat(bool)const;
+	void printStat(bool, bool)const;
 
 	void setSD(size_t d) { if(d < minSAT_D)   minSAT_D   = d; }
 	void setUD(size_t d) { if(d > maxUNSAT_D) maxUNSAT_D = d; }
@@ -178,15 +190,18 @@ protected:
 	size_t  minSAT_D, maxUNSAT_D, maxAbort_D;
 };
 
-class PdrUnsatGenStat : public Stat<2, 2>
+class PdrUnsatGenStat : public Stat<5, 2>
 {
 public:
 	void incRemoveCount(size_t n) { countN(1, n); }
+	void incCtgFoundCount() { countOne(2); }
+	void incCtgBlockCount() { countOne(3); }
+	void incCtgRemoveCount(size_t n) { countN(4, n); }
 
 	void finishRemoveTime() { finishTime(0); }
 	void finishPushTime  () { finishTime(1); }
 
-	void printStat()const;
+	void printStat(bool)const;
 };
 
 class PdrPropStat : public Stat<5, 1>
@@ -200,12 +215,13 @@ public:
 	void printStat()const;
 };
 
-class PdrRecycleStat : public Stat<1, 1>
+class PdrRecycleStat : public Stat<2, 1>
 {
 public:
-	PdrRecycleStat(): Stat<1, 1>(), maxRecNum(0) {}
+	PdrRecycleStat(): Stat<2, 1>(), maxRecNum(0) {}
 
 	void checkMaxRecNum(size_t n) { if(n > maxRecNum) maxRecNum = n; }
+	void incRemovedClsNum(size_t n) { countN(1, n); }
 
 	void printStat()const;
 
@@ -213,14 +229,14 @@ protected:
 	size_t  maxRecNum;
 };
 
-class PdrCubeStat : public Stat<8, 1>
+class PdrCubeStat : public Stat<12, 1>
 {
 public:
 	PdrCubeStat()
-	: Stat<8, 1>   ()
+	: Stat<12, 1>  ()
 	, maxBadNum    (0)
 	, maxInfClsLen (0)
-	, maxTreeSize  (0) {}
+	, maxTreeSize  (0) { SlabAlloc::resetPeak(); }
 
 	void incSubsumeAddObl()        { countOne(1); }
 	void incSelfSubsumeAddObl()    { countOne(2); }
@@ -231,6 +247,12 @@ public:
 	void incInfLitNum(size_t n) { countN(6, n); }
 	void incInfCubeNum()        { countOne(7); }
 
+	void incScanCubeNum(size_t n) { countN(8, n); }
+	void incCandCubeNum(size_t n) { countN(9, n); }
+
+	void incPushOblNum()    { countOne(10); }
+	void incDupOblNum()     { countOne(11); }
+
 	void checkMaxBNum (size_t n) { if(n > maxBadNum)    maxBadNum    = n; }
 	void checkMaxCLen (size_t n) { if(n > maxInfClsLen) maxInfClsLen = n; }
 	void checkMaxTSize(size_t n) { if(n > maxTreeSize)  maxTreeSize  = n; }
@@ -251,7 +273,7 @@ public:
 
 /* The memory alignment of PdrCube
 
-    badDepth    prevCube   hashValue   markA   markB    refCount    litNum | (... literals ...)
+    badDepth    prevCube   abstract    markA   markB    refCount    litNum | (... literals ...)
  |<-   4   ->|<-   8   ->|<-   8   ->|<- 1 ->|<- 1 ->|<-   2   ->|<-  4  ->|<-   4 * litNum   ->|
                                                                         pointer
 */
@@ -283,8 +305,9 @@ public:
 	bool operator< (const PdrCube&)const;
 	bool operator==(const PdrCube&)const;
 
-	void allocMem(unsigned s)
-		{ uint32Ptr = (unsigned*)operator new(sizeof(unsigned) * s + sizeof(unsigned) * 7) + 7; }
+	static size_t getMemSize(unsigned s) { return sizeof(unsigned) * s + sizeof(unsigned) * 7; }
+	void allocMem(unsigned s) { uint32Ptr = (unsigned*)SlabAlloc::allocate(getMemSize(s)) + 7; }
+	void freeMem() { SlabAlloc::deallocate(getOriPtr(), getMemSize(getSize())); }
 
 	void setSize(unsigned s) { *(uint32Ptr - 1) = s; }
 	void setLit(unsigned i, AigGateLit lit) { *(uint32Ptr + i) = lit; }
@@ -297,14 +320,14 @@ public:
 	// Since we preserve the flexibility to use internal signal in representation some day
 	AigGateLit getLit(unsigned i)const { return *(uint32Ptr + i); }
 	size_t getAbs()const { return *(uint64Ptr - 2); }
+	size_t getHash()const;
 
 	bool isCount(unsigned short c)const { return *(uint16Ptr - 3) == c; }
 	void initCount() { *(uint16Ptr - 3) = 0; }
 	void incCount() { *(uint16Ptr - 3) += 1; }
 	void decCount() { *(uint16Ptr - 3) -= 1; }
 	bool toDelete()const { return isCount(0); }
-	// TODO, when the trace is too long, stack overflow occurs
-	void clear() { getPrevCube().~PdrCube(); operator delete(getOriPtr()); }
+	void clear();
 	void decAndCheck() { decCount(); if(toDelete()) clear(); }
 	void clean() { if(!isNone()) decAndCheck(); }
 	void reset() { clean(); uint32Ptr = 0; }
@@ -325,14 +348,18 @@ public:
 	bool isNone()const { return uint32Ptr == 0; }
 	void* getOriPtr()const { return uint32Ptr - 7; }
 
-	bool subsume(const PdrCube& c)const { return subsumeComplexN(c); }
+	bool subsume(const PdrCube& c)const { return subsumeComplexV(c); }
 	bool subsumeTrivial (const PdrCube&)const;
 	bool subsumeComplexN(const PdrCube&)const;
 	bool subsumeComplexB(const PdrCube&)const;
+	bool subsumeComplexV(const PdrCube&)const;
 
-	AigGateLit selfSubsume(const PdrCube& c)const { return selfSubsumeComplex(c); }
-	AigGateLit selfSubsumeTrivial(const PdrCube&)const;
-	AigGateLit selfSubsumeComplex(const PdrCube&)const;
+	AigGateLit selfSubsume(const PdrCube& c)const { return selfSubsumeComplexV(c); }
+	AigGateLit selfSubsumeTrivial (const PdrCube&)const;
+	AigGateLit selfSubsumeComplex (const PdrCube&)const;
+	AigGateLit selfSubsumeComplexV(const PdrCube&)const;
+
+	static const char* getSubsumeKernelStr();
 
 	PdrCube exactOneDiff(const PdrCube&)const;
 	bool    exactOneLess(const PdrCube&)const;
@@ -347,6 +374,12 @@ private:
 };
 static_assert(sizeof(PdrCube) == 8);
 
+struct PdrCubeHash
+	{ size_t operator()(const PdrCube& c)const { return c.getHash(); } };
+
+// The literal sets of the proof obligations queued in one timeframe, to reject the duplicates in O(1)
+using PdrCubeSet = unordered_set<PdrCube, PdrCubeHash>;
+
 class PdrTCube
 {
 public:
@@ -364,6 +397,78 @@ private:
 	PdrCube  cube;
 };
 
+/* Literal occurrence index of a frame
+
+   occurList keeps (literal, position) for every literal of every cube in the frame
+   watchList keeps (literal, position) for the first literal of every cube in the frame
+   Both are sorted by literal
+   - A cube subsuming c must have its first literal in c, so watchList gives the candidates
+   - A cube subsumed by c must contain every literal of c, so the occurrence of the rarest literal in c gives the candidates
+   - absOr is the union of the abstractions, a frame without some literal of c has nothing subsumed by c
+*/
+
+class PdrFrameIndex
+{
+public:
+	PdrFrameIndex(): indexedNum(0), absOr(0), dirty(false) {}
+
+	bool isValid(size_t n)const { return !dirty && indexedNum == n; }
+	void invalidate() { dirty = true; }
+	void build(const vector<PdrCube>&);
+	void add(const PdrCube&);
+
+	void getSubsumerCand(const PdrCube&, vector<unsigned>&)const;
+	void getSubsumedCand(const PdrCube&, vector<unsigned>&)const;
+
+private:
+	using Entry = pair<AigGateLit, unsigned>;
+	using EntryRange = pair<vector<Entry>::const_iterator, vector<Entry>::const_iterator>;
+
+	static void insert(vector<Entry>&, const Entry&);
+	static EntryRange findLit(const vector<Entry>&, AigGateLit);
+
+	vector<Entry>  occurList;
+	vector<Entry>  watchList;
+	size_t         indexedNum;
+	size_t         absOr;
+	bool           dirty;
+};
+
+/* Blocked cubes shared among the threads of parallel PDR
+
+   Every thread owns its network, solver and frames, and the reference count of PdrCube is not atomic,
+   so only the literals are published here. A thread imports the cubes published by the others lazily,
+   and it keeps the number of cubes it has read to know where to continue.
+*/
+class PdrSharedStore
+{
+public:
+	PdrSharedStore(): cubeNum(0), winner(MAX_SIZE_T), isAborted(false) {}
+
+	void publish(size_t, size_t, const PdrCube&);
+	bool hasNew(size_t readNum)const { return cubeNum.load(memory_order_acquire) > readNum; }
+	void fetch(size_t, size_t&, vector<pair<size_t, vector<AigGateLit>>>&)const;
+
+	bool claimWinner(size_t idx) { size_t none = MAX_SIZE_T; return winner.compare_exchange_strong(none, idx); }
+	size_t getWinner()const { return winner; }
+	void abort() { isAborted = true; }
+	bool isDone()const { return isAborted || winner != MAX_SIZE_T; }
+
+private:
+	struct SharedCube
+	{
+		size_t              owner;
+		size_t              frame;
+		vector<AigGateLit>  litList;
+	};
+
+	mutable mutex       cubeLock;
+	vector<SharedCube>  cubeList;
+	atomic<size_t>      cubeNum;
+	atomic<size_t>      winner;
+	atomic<bool>        isAborted;
+};
+
 class PdrChecker;
 PdrChecker* getDefaultPdr(AigNtk*);
 
@@ -372,7 +477,7 @@ class PdrChecker : public SafetyBNChecker
 public:
 	PdrChecker(AigNtk*, size_t, bool, size_t, size_t, size_t, size_t,
 	           PdrSimType, PdrOrdType, PdrOblType, PdrDeqType, PdrPrpType, PdrGenType,
-	           bool, bool, bool, bool, bool, bool, bool, bool, size_t, size_t, size_t, bool,
+	           bool, bool, bool, bool, bool, bool, bool, bool, bool, bool, size_t, size_t, size_t, bool, size_t, size_t, size_t, size_t, size_t,
 	           PdrClsStimuType, PdrShareType, size_t, size_t, size_t,
 	           PdrOblStimuType, PdrShareType, size_t, size_t);
 	~PdrChecker();
@@ -417,11 +522,21 @@ protected:
 	PdrOblStimulator* getOblStimulator(PdrOblStimuType, PdrShareType, bool, size_t, size_t);
 // For stimulator (End)
 
+protected:
+	class PdrPropSolver;
+	class PdrLiftSolver;
+
 protected:
 	void check();
+	void checkMulti();
 
 	PdrResultType checkIntNormal();
 	PdrResultType checkIntOneByOne();
+	PdrResultType checkIntParallel(PdrChecker*&);
+
+	PdrChecker* cloneHelper(size_t)const;
+	void shareBlockedCube(const PdrTCube&)const;
+	void importSharedCubes();
 
 protected:
 	vector<AigGateID> genTarget(const PdrCube&)const;
@@ -432,8 +547,11 @@ protected:
 	void generalizeDefault(size_t&);
 	void generalizeClause (size_t&);
 	void generalizeCube   (size_t&);
+	PdrCube getCtg(size_t, size_t, size_t)const;
+	bool blockCtg(const PdrCube&, size_t);
 
 	bool propBlockedCubes();
+	void propInParallel(size_t, const vector<PdrCube>&, vector<size_t>&, vector<vector<AigGateLit>>&);
 
 	PdrCube getNotPCube()const;
 	size_t isBlockedSAT(const PdrTCube&)const;
@@ -452,8 +570,11 @@ protected:
 	void    terSimForwardEvent    (const vector<AigGateID>&)const;
 	void    terSimBackwardNormal  (const vector<AigGateID>&)const;
 	void    terSimBackwardInternal(const vector<AigGateID>&)const;
-	void satGenBySAT(const vector<AigGateLit>&)const;
+	void    terSimLift            (const vector<AigGateID>&)const;
 	void genSimCand(const vector<AigGateID>&)const;
+	bool getInputValue(size_t i)const { return getModelValue(ntk->getInputID(i), i); }
+	bool getLatchValue(size_t i)const { return getModelValue(ntk->getLatchID(i), ntk->getInputNum() + i); }
+	bool getModelValue(AigGateID, size_t)const;
 	void sortGenCubeByAct()const;
 
 	Var addCurNotState (const PdrCube&)const;
@@ -462,10 +583,13 @@ protected:
 	void addNextState(const PdrCube& c)const { addState(c, 1); }
 	void activateFrame(size_t)const;
 	PdrCube unsatGen(const PdrCube&)const;
-	size_t findLowestActPlus1(size_t)const;
+	void unsatGen(const PdrCube&, const CirSolver*, vector<AigGateLit>&)const;
+	size_t findLowestActPlus1(size_t f)const { return findLowestActPlus1(f, solver, actVar); }
+	static size_t findLowestActPlus1(size_t, const CirSolver*, const vector<Var>&);
 	bool isInitial(const vector<AigGateLit>&, size_t = MAX_SIZE_T)const;
 	Var addCurNotState(const vector<AigGateLit>&, size_t = MAX_SIZE_T)const;
 	void addNextState(const vector<AigGateLit>&, size_t = MAX_SIZE_T)const;
+	Var setGenQuery(size_t, size_t)const;
 
 	void printCurFrames(const char*)const;
 	void printRemainObl()const;
@@ -474,19 +598,31 @@ protected:
 	bool isOrdDecay()const { return ordType & 0b10; }
 	bool isOrdReverse()const { return ordType & 0b01; }
 	bool isOrdDynamic()const { return ordType != PDR_ORD_INDEX; }
+	bool isActivityON()const { return isOrdDynamic() || deqType == PDR_DEQ_ACTIVITY; }
+	bool isDeqHeap()const { return deqType >= PDR_DEQ_SMALL; }
 
 	bool satSolve()const;
 	bool satSolveLimited()const;
 	void disableActVar(Var)const;
 	void checkRecycle();
+	void selectSolver(size_t)const;
+	void switchSolver(size_t)const;
+	void discardFrameSolvers(size_t)const;
 	void convertCNF()const;
 	void convertCNF(const PdrCube&)const;
+	const CirCnfTemplate& getCnfTemplate()const
+		{ if(cnfTemplate == 0) cnfTemplate = new CirCnfTemplate(ntk, cutMap); return *cnfTemplate; }
 	void convertFrame(size_t)const;
 	void addInitState()const;
 
 	void refineInf();
 	void checkMaxD(size_t d)const { if(d > maxUNSAT_D) maxUNSAT_D = d; }
 	void checkThenPushObl(size_t, const PdrCube&);
+	const PdrCube& getBadCube(size_t);
+	void popBadCube(size_t);
+	void clearObl();
+	bool isLowerPriority(const PdrCube&, const PdrCube&)const;
+	double getOblActivity(const PdrCube&)const;
 	bool isVerboseON(PdrVerboseType pvt)const { return verbosity & getPdrVbsMask(pvt); }
 	void checkAndPrintIndInv();
 	size_t getCurRecycleNum()const { return recycleByQuery ? satQueryTime : unusedVarNum; }
@@ -495,6 +631,9 @@ protected:
 	void pushToFrameInf(size_t);
 	bool checkIsSubsumed(const PdrCube&, size_t, size_t)const;
 	void checkSubsumeOthers(const PdrCube&, size_t, size_t);
+	bool isSubsumedInFrame(const PdrCube&, size_t)const;
+	const PdrFrameIndex& getFrameIndex(size_t)const;
+	void invalidateIndex(size_t f)const { frameIndex[f].invalidate(); }
 	void printTrace()const;
 	void collectInd();
 
@@ -527,16 +666,24 @@ protected:
 
 	mutable size_t  maxUNSAT_D;
 
-	vector<vector<PdrCube>>  frame;
-	SolverPtr<CirSolver>     solver;
-	vector<Var>              actVar;
+	vector<vector<PdrCube>>        frame;
+	mutable vector<PdrFrameIndex>  frameIndex;
+	mutable vector<unsigned>       candList;
+	CirCutMap*                     cutMap; // shared by all the solvers and the template
+	SolverPtr<CirSolver>           mainSolver;
+	mutable CirSolver*             solver;
+	mutable CirCnfTemplate*        cnfTemplate;
+	mutable vector<Var>            actVar;
 
 	vector<deque<PdrCube>>      badDequeVec;
+	vector<PdrCubeSet>          badSetVec;
+	vector<size_t>              badHeapStamp;
 	mutable AigSimulator        terSimSup;
 	mutable vector<AigGateLit>  genCube;
 
 	Array<double>  activity;
 	double         actInc;
+	size_t         actBumpNum;
 
 	StatPtr<PdrTerSimStat>    terSimStat;
 	StatPtr<PdrSatStat>       satStat;
@@ -557,8 +704,10 @@ protected:
 	bool        checkSelf;
 	bool        assertFrame;
 	bool        recycleByQuery;
+	bool        recycleIncr;
 	bool        lazyProp;
 	bool        sortByBadDepth;
+	bool        perFrameSolver;
 	bool        checkIndInv;
 
 	mutable size_t  frameConverted;
@@ -574,35 +723,62 @@ protected:
 
 	size_t  verbosity;
 
-	static constexpr size_t FRAME_NULL = MAX_SIZE_T - 1;
-	static constexpr size_t FRAME_INF  = MAX_SIZE_T;
+	// For parallel PDR, thread 0 owns the shared store and the helpers
+	size_t                threadNum;
+	size_t                threadIdx;
+	PdrSharedStore*       sharedStore;
+	size_t                sharedReadNum;
+	vector<PdrChecker*>   helperList;
+
+	// For parallel propagation, each solver checks a slice of the cubes in a frame
+	size_t                   propThreadNum;
+	vector<PdrPropSolver*>   propSolverList;
+
+	// For per-frame solvers, solver i only holds the lemmas of frames >= i and is created at its first query
+	// The one in use is pointed by solver, and the others keep their activation variables aside
+	struct PdrFrameSolver
+	{
+		CirSolver*   s = 0;
+		vector<Var>  actVar;
+		size_t       frameConverted = 0;
+	};
+	mutable vector<PdrFrameSolver>  frameSolverList;
+	mutable size_t                  curSolverIdx;
+
+	// For lifting, the predecessors are generalized by a solver with only the transition relation
+	PdrLiftSolver*  liftSolver;
+
+	// For CTG generalization, the number of CTGs tried per literal and the depth of recursion are limited
+	size_t  ctgNumLimit;
+	size_t  ctgDepthLimit;
+	size_t  ctgDepth;
+
+	// For the simulation filter, the states of the SAT solutions are kept in a ring of blocks, 64 states for each,
+	// and a query satisfied by one of them is known to be SAT without calling the solver
+	// The matched state then stands for the solution, as patHit = block * 64 + bit
+	bool checkPatForSat(size_t f, const PdrCube& c, bool notCur)const
+		{ return checkPatForSat(f, c.begin(), c.getSize(), MAX_SIZE_T, notCur); }
+	bool checkPatForSat(size_t f, size_t ignoreIdx)const
+		{ return checkPatForSat(f, genCube.data(), genCube.size(), ignoreIdx, true); }
+	bool checkPatForSat(size_t f)const
+		{ return checkPatForSat(f, 0, 0, MAX_SIZE_T, false); }
+	bool checkPatForSat(size_t, const AigGateLit*, size_t, size_t, bool)const;
+	void checkPatFrame(size_t)const;
+	void simAllAnd()const;
+	void setPattern(size_t)const;
+	void collectPattern()const;
 
-#ifdef UsePatternCheckSAT
-protected:
+	size_t                         patBlockNum;
 	mutable vector<Array<size_t>>  pattern;
+	mutable size_t                 patBlock;
 	mutable size_t                 patIdx;
+	mutable size_t                 patHit;
 	mutable size_t                 simMask;
 	mutable Array<size_t>          simValue;
-	mutable vector<AigAnd*>        dfsList;
-	mutable size_t                 matchTry;
-	mutable size_t                 matchFrame;
-	mutable size_t                 matchSAT;
-	mutable clock_t                matchTime;
-	mutable bool                   simResult;
+	mutable vector<AigGateID>      dfsList;
 
-	void checkPatForSat(size_t, const PdrCube&)const;
-	void checkPatForSat(size_t, size_t)        const;
-	void checkPatForSat(size_t)                const;
-
-	void genDfsList(const PdrCube&)const;
-	void genDfsList(size_t)const;
-	void genDfsList()const;
-
-	void checkPatFrame(size_t)const;
-	void simAllAnd()const;
-	void setPattern(size_t)const;
-	void collectPattern()const;
-#endif
+	static constexpr size_t FRAME_NULL = MAX_SIZE_T - 1;
+	static constexpr size_t FRAME_INF  = MAX_SIZE_T;
 
 #ifdef CheckOblCommonPart
 protected:
@@ -616,6 +792,42 @@ protected:
 #endif
 };
 
+class PdrChecker::PdrPropSolver
+{
+public:
+	PdrPropSolver(const PdrChecker* c): checker(c), solver(c->ntk, c->cutMap), loaded(false) {}
+	~PdrPropSolver() {}
+
+	void reset() { loaded = false; }
+	void addBlockedCube(size_t, const PdrCube&);
+	size_t solveRelative(size_t, const PdrCube&, vector<AigGateLit>&);
+
+private:
+	void load(size_t);
+	void syncActVar();
+
+private:
+	const PdrChecker*     checker;
+	SolverPtr<CirSolver>  solver;
+	vector<Var>           actVar;
+	vector<Lit>           litList;
+	bool                  loaded;
+};
+
+class PdrChecker::PdrLiftSolver
+{
+public:
+	PdrLiftSolver(const PdrChecker* c): solver(c->ntk, c->cutMap), disabledNum(0) {}
+	~PdrLiftSolver() {}
+
+	void lift(const vector<AigGateID>&, const vector<AigGateLit>&, vector<AigGateLit>&);
+
+private:
+	SolverPtr<CirSolver>  solver;
+	vector<Lit>           litList;
+	size_t                disabledNum;
+};
+
 class PdrChecker::PdrStimulator
 {
 public:
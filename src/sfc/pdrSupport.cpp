@@ -4,6 +4,7 @@
 |: [Synopsis] Implement some utilities to support PDR checker            :|
 <------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include "pdrChecker.h"
 
 namespace _54ff
@@ -66,6 +67,82 @@ PdrCube::exactOneLess(const PdrCube& c)const
 	return getSize() + 1 == c.getSize() && subsume(c);
 }
 
+void
+PdrFrameIndex::build(const vector<PdrCube>& cubeList)
+{
+	occurList.clear();
+	watchList.clear();
+	absOr = 0;
+	for(unsigned i = 0, n = cubeList.size(); i < n; ++i)
+	{
+		const PdrCube& c = cubeList[i];
+		for(unsigned j = 0; j < c.getSize(); ++j)
+			occurList.emplace_back(c.getLit(j), i);
+		if(c.getSize() != 0)
+			watchList.emplace_back(c.getLit(0), i);
+		absOr |= c.getAbs();
+	}
+	sort(occurList.begin(), occurList.end());
+	sort(watchList.begin(), watchList.end());
+	indexedNum = cubeList.size();
+	dirty = false;
+}
+
+void
+PdrFrameIndex::add(const PdrCube& c)
+{
+	assert(!dirty);
+	const unsigned pos = indexedNum++;
+	for(unsigned j = 0; j < c.getSize(); ++j)
+		insert(occurList, Entry(c.getLit(j), pos));
+	if(c.getSize() != 0)
+		insert(watchList, Entry(c.getLit(0), pos));
+	absOr |= c.getAbs();
+}
+
+void
+PdrFrameIndex::getSubsumerCand(const PdrCube& c, vector<unsigned>& cand)const
+{
+	cand.clear();
+	for(unsigned i = 0; i < c.getSize(); ++i)
+		for(auto [it, end] = findLit(watchList, c.getLit(i)); it != end; ++it)
+			cand.push_back(it->second);
+}
+
+void
+PdrFrameIndex::getSubsumedCand(const PdrCube& c, vector<unsigned>& cand)const
+{
+	cand.clear();
+	if((absOr & c.getAbs()) != c.getAbs())
+		return;
+	if(c.getSize() == 0)
+	{
+		for(unsigned i = 0; i < indexedNum; ++i)
+			cand.push_back(i);
+		return;
+	}
+	EntryRange rarest = findLit(occurList, c.getLit(0));
+	for(unsigned i = 1; i < c.getSize() && rarest.first != rarest.second; ++i)
+		if(EntryRange r = findLit(occurList, c.getLit(i));
+		   r.second - r.first < rarest.second - rarest.first)
+			rarest = r;
+	for(auto it = rarest.first; it != rarest.second; ++it)
+		cand.push_back(it->second);
+}
+
+void
+PdrFrameIndex::insert(vector<Entry>& entryList, const Entry& e)
+{
+	entryList.insert(upper_bound(entryList.begin(), entryList.end(), e), e);
+}
+
+auto
+PdrFrameIndex::findLit(const vector<Entry>& entryList, AigGateLit lit) -> EntryRange
+{
+	return EntryRange(lower_bound(entryList.begin(), entryList.end(), Entry(lit, 0)),
+	                  lower_bound(entryList.begin(), entryList.end(), Entry(lit+1, 0)));
+}
+
 void
 PdrChecker::PdrStimulator::printStats()const
 {
@@ -81,7 +158,7 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 		stimuStat->startTime();
 
 	if(checker->isVerboseON(PDR_VERBOSE_STIMU))
-		cout << "Try " << candCube << flush;
+		sfcOut << "Try " << candCube << flush;
 	const string resultStr[] = { "PASS", "FAIL", "ABORT" };
 	size_t r;
 
@@ -106,6 +183,9 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 		vector<deque<PdrCube>> badDV(move(checker->badDequeVec));
 		checker->badDequeVec.resize(checker->oblType == PDR_OBL_PUSH ? checker->frame.size()
 		                                                             : checker->frame.size() - 1);
+		vector<PdrCubeSet> badSV(move(checker->badSetVec));
+		checker->badSetVec.resize(checker->badDequeVec.size());
+		checker->badHeapStamp.clear();
 		bool checkII = checker->checkIndInv;
 		checker->checkIndInv = false;
 		size_t totalSQ = checker->totalSatQuery;
@@ -128,8 +208,8 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 			default               : r = 2; break;
 		}
 		if(verbose)
-			cout << " -> " << resultStr[r] << endl
-			     << "#SAT query = " << checker->totalSatQuery << endl;
+			sfcOut << " -> " << resultStr[r] << endl
+			       << "#SAT query = " << checker->totalSatQuery << endl;
 		if(r == 1) addToFailed(candCube);
 
 		// Restore the parameter
@@ -141,6 +221,9 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 		checker->badDequeVec.swap(badDV);
 		checker->badDequeVec.resize(checker->oblType == PDR_OBL_PUSH ? checker->frame.size()
 		                                                             : checker->frame.size() - 1);
+		checker->badSetVec.swap(badSV);
+		checker->badSetVec.resize(checker->badDequeVec.size());
+		checker->badHeapStamp.clear();
 		checker->checkIndInv = checkII;
 		checker->totalSatQuery = totalSQ;
 		checker->satQueryLimit = satQL;
@@ -170,6 +253,8 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 			// Be careful, we already know stimuChecker is done currently
 			// If we still need frame.back(), modify this line
 			stimuChecker->frame.back().swap(checker->frame.back());
+			stimuChecker->invalidateIndex(stimuChecker->frame.size() - 1);
+			checker->invalidateIndex(checker->frame.size() - 1);
 			stimuChecker->addBlockedCubeInf();
 			for(PdrCube& c: stimuChecker->frame.back())
 				{ assert(!c.getMarkB()); c.setMarkB(true); }
@@ -182,8 +267,8 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 			default               : r = 2; break;
 		}
 		if(checker->isVerboseON(PDR_VERBOSE_STIMU))
-			cout << " -> " << resultStr[r] << endl
-			     << "#SAT query = " << stimuChecker->totalSatQuery;
+			sfcOut << " -> " << resultStr[r] << endl
+			       << "#SAT query = " << stimuChecker->totalSatQuery;
 
 		if(shareType == PDR_SHARE_INF)
 		{
@@ -193,6 +278,7 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 				// Be careful, we already know stimuChecker is done currently
 				// If we still need stimuChecker, modify this line
 				checker->frame.back().swap(stimuChecker->frame.back());
+				checker->invalidateIndex(checker->frame.size() - 1);
 				vector<PdrCube>& infFrame = checker->frame.back();
 				size_t numNewCls = 0;
 				for(const PdrCube& c: infFrame)
@@ -203,7 +289,7 @@ PdrChecker::PdrStimulator::solveCand(const PdrCube& candCube, unsigned mergeType
 						numNewCls += 1;
 					}
 				if(checker->isVerboseON(PDR_VERBOSE_STIMU))
-					cout << ", #new clauses = " << numNewCls << endl;
+					sfcOut << ", #new clauses = " << numNewCls << endl;
 				incInfClsNum(numNewCls);
 				for(PdrCube& c: infFrame)
 					if(c.getMarkB())
@@ -380,19 +466,19 @@ PdrChecker::PdrOblStimulatorAll::checkCommonPart(const PdrCube& c)
 void
 PdrChecker::PdrOblStimulatorAll::printCommon()const
 {
-	cout << RepeatChar('=', 36) << endl;
+	sfcOut << RepeatChar('=', 36) << endl;
 	if(numObl == 0)
-		cout << "No proof obligation!" << endl;
+		sfcOut << "No proof obligation!" << endl;
 	else
 	{
-		cout << "Number of proof obligation = " << numObl << endl
-		     << "Common part:";
+		sfcOut << "Number of proof obligation = " << numObl << endl
+		       << "Common part:";
 		if(commonPart.empty())
-			cout << " None";
+			sfcOut << " None";
 		else
 			for(AigGateLit lit: commonPart)
-				cout << " " << (isInv(lit) ? "!" : "") << getGateID(lit);
-		cout << endl;
+				sfcOut << " " << (isInv(lit) ? "!" : "") << getGateID(lit);
+		sfcOut << endl;
 	}
 }
 
@@ -460,27 +546,27 @@ PdrChecker::PdrOblStimulatorDepth::checkCommonPart(const PdrCube& c)
 void
 PdrChecker::PdrOblStimulatorDepth::printCommon()const
 {
-	cout << RepeatChar('=', 36) << endl;
+	sfcOut << RepeatChar('=', 36) << endl;
 	size_t end = 0;
 	for(size_t n = numObl.size(); end < n && numObl[end] != 0; ++end);
 	if(end == 0)
-		cout << "No proof obligation!" << endl;
+		sfcOut << "No proof obligation!" << endl;
 	else
 	{
-		cout << "Number of proof obligation:" << endl;
+		sfcOut << "Number of proof obligation:" << endl;
 		for(size_t i = 0; i < end; ++i)
-			cout << i << ": " << numObl[i] << endl;
-		cout << RepeatChar('-', 36) << endl;
-		cout << "Common part:" << endl;
+			sfcOut << i << ": " << numObl[i] << endl;
+		sfcOut << RepeatChar('-', 36) << endl;
+		sfcOut << "Common part:" << endl;
 		for(size_t i = 0; i < end; ++i)
 		{
-			cout << i << ":";
+			sfcOut << i << ":";
 			if(commonPart[i].empty())
-				cout << " None";
+				sfcOut << " None";
 			else
 				for(AigGateLit lit: commonPart[i])
-					cout << " " << (isInv(lit) ? "!" : "") << getGateID(lit);
-			cout << endl;
+					sfcOut << " " << (isInv(lit) ? "!" : "") << getGateID(lit);
+			sfcOut << endl;
 		}
 	}
 }
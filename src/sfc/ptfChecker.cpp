@@ -0,0 +1,196 @@
+/*========================================================================\
+|: [Filename] ptfChecker.cpp                                             :|
+:| [Author]   Chiang Chun-Yi                                             |:
+|: [Synopsis] Implement the portfolio checker                            :|
+<------------------------------------------------------------------------*/
+
+#include <thread>
+#include <chrono>
+#include "ptfChecker.h"
+#include "bmcChecker.h"
+#include "pdrChecker.h"
+#include "pbcChecker.h"
+
+namespace _54ff
+{
+
+const string ptfEngineStr[PTF_ENGINE_TOTAL] =
+{
+	"PDR",
+	"PBC",
+	"BMC",
+	"IND",
+	"ITP"
+};
+
+PtfChecker::PtfChecker(AigNtk* ntkToCheck, size_t outputI, bool _trace, size_t timeout,
+                       size_t maxD, const Array<bool>& engine, bool _verbose)
+: SafetyBNChecker (ntkToCheck, outputI, _trace, timeout)
+, outputIdx       (outputI)
+, maxDepth        (maxD)
+, wallTimeout     (timeout)
+, verbose         (_verbose)
+, stopFlag        (false)
+, finishNum       (0)
+, winner          (MAX_SIZE_T)
+{
+	for(unsigned i = 0; i < PTF_ENGINE_TOTAL; ++i)
+		if(engine[i])
+		{
+			engineList.emplace_back();
+			engineList.back().type = PtfEngineType(i);
+		}
+	if(engineList.empty())
+		throw CheckerErr("[Error] No engine is selected for the portfolio!");
+
+	sfcMsg << "Max depth  : " << maxDepth << endl
+	       << "Method     : Portfolio" << endl
+	       << "Engines    :";
+	for(const EngineRecord& e: engineList)
+		sfcMsg << " " << ptfEngineStr[e.type];
+	sfcMsg << endl;
+}
+
+void
+PtfChecker::check()
+{
+	// Checking a network writes the marks of its gates, e.g. in checkCombLoop and noLatchInCone,
+	// so every engine gets a private copy, made here before any worker starts
+	for(EngineRecord& e: engineList)
+		e.ownNtk = ntk->copyNtk(),
+		e.result = SFC_RESULT_UNKNOWN,
+		e.isStopped = false,
+		e.wallTime = 0;
+	stopFlag = false;
+	finishNum = 0;
+	winner = MAX_SIZE_T;
+
+	vector<thread> workers;
+	workers.reserve(engineList.size());
+	for(size_t i = 0, n = engineList.size(); i < n; ++i)
+		workers.emplace_back(&PtfChecker::runEngine, this, i);
+
+	{
+		unique_lock<mutex> lock(resultLock);
+		auto isDone = [this]() { return winner != MAX_SIZE_T || finishNum == engineList.size(); };
+		if(wallTimeout == 0)
+			resultCond.wait(lock, isDone);
+		else if(!resultCond.wait_for(lock, chrono::seconds(wallTimeout), isDone))
+			stopFlag = true;
+	}
+	// The raised flag also gives up the running solves, so every worker returns shortly
+	for(thread& t: workers)
+		t.join();
+
+	printReport();
+	if(winner != MAX_SIZE_T)
+		setResult(engineList[winner].result);
+}
+
+void
+PtfChecker::runEngine(size_t idx)
+{
+	EngineRecord& e = engineList[idx];
+	// The stream of the checkers is private to the thread, so only its buffer is replaced
+	sfcOut.rdbuf(&e.log);
+	const auto start = chrono::steady_clock::now();
+
+	if(SafetyChecker* checker = buildEngine(e.type, e.ownNtk); checker != 0)
+	{
+		checker->CheckInThread(&stopFlag);
+		e.result = checker->getResult();
+		delete checker;
+	}
+	delete e.ownNtk;
+	e.ownNtk = 0;
+
+	e.wallTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	lock_guard<mutex> lock(resultLock);
+	if(e.result != SFC_RESULT_UNKNOWN && winner == MAX_SIZE_T)
+		{ winner = idx; stopFlag = true; }
+	else if(e.result == SFC_RESULT_UNKNOWN)
+		e.isStopped = stopFlag;
+	finishNum += 1;
+	resultCond.notify_one();
+}
+
+SafetyChecker*
+PtfChecker::buildEngine(PtfEngineType type, AigNtk* ownNtk)const
+{
+	constexpr size_t noTimeout = 0;
+	switch(type)
+	{
+		case PTF_ENGINE_BMC:
+			return getChecker<BmcChecker>(ownNtk, outputIdx, trace, noTimeout, maxDepth, BMC_ONLY_LAST, false);
+
+		case PTF_ENGINE_IND:
+			return getChecker<IndChecker>(ownNtk, outputIdx, trace, noTimeout, maxDepth, IND_SIMPLE_NEED);
+
+		case PTF_ENGINE_ITP:
+			return getChecker<ItpChecker>(ownNtk, outputIdx, trace, noTimeout, maxDepth, ITP_ASSERT);
+
+		case PTF_ENGINE_PBC:
+		{
+			Array<bool> noStat(PBC_STAT_TOTAL);
+			for(unsigned i = 0; i < PBC_STAT_TOTAL; ++i)
+				noStat[i] = false;
+			return getChecker<PbcIChecker>(ownNtk, outputIdx, trace, noTimeout, maxDepth, noStat, false);
+		}
+
+		case PTF_ENGINE_PDR:
+		{
+			constexpr size_t noStat     = 0;
+			constexpr size_t noRecycle  = 0;
+			constexpr size_t noSatLimit = 0;
+			constexpr size_t noOblLimit = 0;
+			constexpr size_t vbsOff     = 0;
+			constexpr size_t oneThread  = 1;
+			constexpr size_t dummy      = 0;
+			return getChecker<PdrChecker>(ownNtk, outputIdx, trace, noTimeout, maxDepth, noRecycle, noStat,
+			                              PDR_SIM_FORWARD_NORMAL, PDR_ORD_INDEX, PDR_OBL_NORMAL, PDR_DEQ_STACK, PDR_PRP_NORMAL, PDR_GEN_NORMAL,
+			                              false, false, false, false, false, false, false, false, false, false,
+			                              noSatLimit, noOblLimit, vbsOff, false, oneThread, oneThread, dummy, dummy, dummy,
+			                              PDR_CLS_STIMU_NONE, PDR_SHARE_NONE, dummy, dummy, dummy,
+			                              PDR_OBL_STIMU_NONE, PDR_SHARE_NONE, dummy, dummy);
+		}
+
+		default: assert(false); return 0;
+	}
+}
+
+void
+PtfChecker::printReport()const
+{
+	if(verbose)
+		for(const EngineRecord& e: engineList)
+			sfcOut << RepeatChar('=', 36) << endl
+			       << "Log of " << ptfEngineStr[e.type] << endl
+			       << e.log.str();
+	else if(winner != MAX_SIZE_T)
+		sfcOut << engineList[winner].log.str();
+
+	sfcOut << RepeatChar('=', 36) << endl
+	       << "Engine  Verdict  Wall time" << endl;
+	streamsize ss = sfcOut.precision();
+	sfcOut << fixed << setprecision(3);
+	for(size_t i = 0, n = engineList.size(); i < n; ++i)
+	{
+		const EngineRecord& e = engineList[i];
+		sfcOut << left << setw(8) << ptfEngineStr[e.type] << setw(9);
+		switch(e.result)
+		{
+			case SFC_RESULT_SAT   : sfcOut << "SAT";                                  break;
+			case SFC_RESULT_UNSAT : sfcOut << "UNSAT";                                break;
+			default               : sfcOut << (e.isStopped ? "STOPPED" : "UNKNOWN"); break;
+		}
+		sfcOut << right << e.wallTime << " s";
+		if(i == winner) sfcOut << " (winner)";
+		sfcOut << endl;
+	}
+	sfcOut << setprecision(ss);
+	sfcOut.unsetf(ios_base::floatfield);
+	if(winner == MAX_SIZE_T)
+		sfcOut << "Cannot determinie the property" << endl;
+}
+
+}
@@ -0,0 +1,74 @@
+/*========================================================================\
+|: [Filename] ptfChecker.h                                               :|
+:| [Author]   Chiang Chun-Yi                                             |:
+|: [Synopsis] Define the portfolio checker which races several engines  :|
+:|            in parallel threads and reports the first verdict          |:
+<------------------------------------------------------------------------*/
+
+#ifndef HEHE_PTFCHECKER_H
+#define HEHE_PTFCHECKER_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <sstream>
+#include "sfcChecker.h"
+
+namespace _54ff
+{
+
+enum PtfEngineType
+{
+	PTF_ENGINE_PDR = 0,
+	PTF_ENGINE_PBC,
+	PTF_ENGINE_BMC,
+	PTF_ENGINE_IND,
+	PTF_ENGINE_ITP,
+	PTF_ENGINE_TOTAL,
+	PTF_ENGINE_ERROR,
+	PTF_ENGINE_ALL
+};
+
+extern const string ptfEngineStr[PTF_ENGINE_TOTAL];
+
+class PtfChecker : public SafetyBNChecker
+{
+public:
+	PtfChecker(AigNtk*, size_t, bool, size_t, size_t, const Array<bool>&, bool);
+	~PtfChecker() {}
+
+protected:
+	void check();
+
+private:
+	void runEngine(size_t);
+	SafetyChecker* buildEngine(PtfEngineType, AigNtk*)const;
+	void printReport()const;
+
+private:
+	struct EngineRecord
+	{
+		PtfEngineType  type;
+		AigNtk*        ownNtk;
+		SfcResultType  result;
+		bool           isStopped;
+		double         wallTime;
+		stringbuf      log;
+	};
+
+	size_t                outputIdx;
+	size_t                maxDepth;
+	size_t                wallTimeout;
+	bool                  verbose;
+	vector<EngineRecord>  engineList;
+
+	atomic<bool>          stopFlag;
+	mutex                 resultLock;
+	condition_variable    resultCond;
+	size_t                finishNum;
+	size_t                winner;
+};
+
+}
+
+#endif
@@ -11,20 +11,28 @@
 namespace _54ff
 {
 
-CondStream sfcMsg(cout);
+thread_local ostream    sfcOut(cout.rdbuf());
+thread_local CondStream sfcMsg(sfcOut);
 
 SafetyChecker::SafetyChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, size_t timeout,
                              bool supportB, bool ntkIsC)
 : ntk          (ntkIsC ? ntkToCheck->copyNtk() : ntkToCheck)
-, property     (ntk->getOutputID(outputIdx))
+, property     (ntk->getOutputID(outputIdx == SFC_ALL_OUTPUT ? 0 : outputIdx))
+, allOutput    (outputIdx == SFC_ALL_OUTPUT)
 , trace        (_trace)
 , supportBreak (supportB)
 , ntkIsCopied  (ntkIsC)
-, timeBound    (timeout == 0 ? 0 : clock() + (timeout * CLOCKS_PER_SEC))
+, timeBound    (timeout == 0 ? chrono::steady_clock::time_point::max()
+                            : chrono::steady_clock::now() + chrono::seconds(timeout))
+, result       (SFC_RESULT_UNKNOWN)
+, stopFlag     (0)
 {
 	sfcMsg << RepeatChar('=', 36) << endl
 	       << "Network    : " << ntk->ntkName << endl
-	       << "Property   : output " << outputIdx << ", ID " << property << endl
+	       << "Property   : ";
+	if(allOutput) sfcMsg << "all the " << ntk->getOutputNum() << " outputs";
+	else          sfcMsg << "output " << outputIdx << ", ID " << property;
+	sfcMsg << endl
 	       << "Report CEX : " << (trace ? "Yes" : "No") << endl
 	       << "Timeout    : ";
 	if(timeout == 0) sfcMsg << "unlimited";
@@ -35,7 +43,7 @@ SafetyChecker::SafetyChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace,
 void
 SafetyChecker::Check()
 { 
-	cout << RepeatChar('=', 36) << endl;
+	sfcOut << RepeatChar('=', 36) << endl;
 	isIntSent = false;
 	isStpSent = false;
 	supportBreakNow = supportBreak;
@@ -46,6 +54,18 @@ SafetyChecker::Check()
 	signal(SIGTSTP, oldStpHandler);
 }
 
+void
+SafetyChecker::CheckInThread(const atomic<bool>* stop)
+{
+	stopFlag = stop;
+	CirSolver::setThreadStop(stop);
+	// The answer of a solve given up halfway means nothing, so the check is left at once
+	try { check(); }
+	catch(const SolverStop&) { sfcMsg << "\rStopped by another engine during SAT solving" << endl; }
+	CirSolver::setThreadStop(0);
+	stopFlag = 0;
+}
+
 bool
 SafetyChecker::checkBreakCond()const
 {
@@ -54,14 +74,34 @@ SafetyChecker::checkBreakCond()const
 		sfcMsg << "\rReceive interruption signal";
 		return true;
 	}
-	if(timeBound != 0 && clock() >= timeBound)
+	if(chrono::steady_clock::now() >= timeBound)
 	{
 		sfcMsg << "\rTimeout";
 		return true;
 	}
+	if(stopFlag != 0 && stopFlag->load(memory_order_relaxed))
+	{
+		sfcMsg << "\rStopped by another engine";
+		return true;
+	}
 	return false;
 }
 
+// For the property without latch in its cone, the message is printed before the trace if it fails
+bool
+SafetyChecker::checkComb(const string& satMsg)const
+{
+	SolverPtr<CirSolver> solver(ntk);
+	solver->convertToCNF(property, 0);
+	solver->clearAssump();
+	solver->addAssump(property, 0, false);
+	if(!solver->solve())
+		return false;
+	sfcOut << satMsg << endl;
+	if(trace) solver->reportTrace(sfcOut, 0);
+	return true;
+}
+
 AigGateV
 SafetyChecker::buildInit()
 {
@@ -89,24 +129,17 @@ SafetyChecker::catchStpsignal(int)
 
 void (*SafetyChecker::oldIntHandler)(int) = 0;
 void (*SafetyChecker::oldStpHandler)(int) = 0;
-bool SafetyChecker::isIntSent = false;
-bool SafetyChecker::isStpSent = false;
+atomic<bool> SafetyChecker::isIntSent(false);
+atomic<bool> SafetyChecker::isStpSent(false);
 bool SafetyChecker::supportBreakNow = false;
 
 void
 CombChecker::check()
 {
-	SolverPtr<CirSolver> solver(ntk);
-	solver->convertToCNF(property, 0);
-	solver->clearAssump();
-	solver->addAssump(property, 0, false);
-	if(solver->solve())
-	{
-		cout << "Observe a counter example" << endl;
-		if(trace) solver->reportTrace(0);
-	}
+	if(checkComb("Observe a counter example"))
+		setResult(SFC_RESULT_SAT);
 	else
-		cout << "Property proved" << endl;
+		{ sfcOut << "Property proved" << endl; setResult(SFC_RESULT_UNSAT); }
 }
 
 }
@@ -9,6 +9,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <atomic>
+#include <chrono>
 #include "aigNtk.h"
 #include "condStream.h"
 using namespace std;
@@ -16,7 +18,20 @@ using namespace std;
 namespace _54ff
 {
 
-extern CondStream  sfcMsg;
+// The messages of the checkers go to a stream of their own thread, over the buffer of cout by default,
+// so an engine of the portfolio writes its log with a format state no other engine touches
+extern thread_local ostream     sfcOut;
+extern thread_local CondStream  sfcMsg;
+
+enum SfcResultType
+{
+	SFC_RESULT_UNKNOWN,
+	SFC_RESULT_SAT,
+	SFC_RESULT_UNSAT
+};
+
+// Passed as the output index to check all the outputs in one run
+constexpr size_t SFC_ALL_OUTPUT = MAX_SIZE_T;
 
 class SafetyChecker
 {
@@ -25,13 +40,18 @@ public:
 	virtual ~SafetyChecker() { if(ntkIsCopied) delete ntk; }
 
 	void Check();
+	// Run without touching the signal handlers, used by the portfolio threads
+	void CheckInThread(const atomic<bool>*);
 
 	virtual bool isComb()const { return false; }
+	SfcResultType getResult()const { return result; }
 
 protected:
 	virtual void check() = 0;
+	void setResult(SfcResultType r) { result = r; }
 
 	AigGateV buildInit();
+	bool checkComb(const string&)const;
 
 	bool checkBreakCond()const;
 	bool checkIsStopped()const { return isStpSent; }
@@ -44,15 +64,21 @@ protected:
 protected:
 	AigNtk*     ntk;
 	AigGateID   property;
+	bool        allOutput;
 	bool        trace;
 	bool        supportBreak;
 	bool        ntkIsCopied;
-	clock_t     timeBound;
+
+	// Wall-clock time, since the CPU time grows faster with the threads of parallel PDR
+	chrono::steady_clock::time_point  timeBound;
+
+	SfcResultType        result;
+	const atomic<bool>*  stopFlag;
 
 	// TODO, support suspending
-	static bool  isIntSent;
-	static bool  isStpSent;
-	static bool  supportBreakNow;
+	static atomic<bool>  isIntSent;
+	static atomic<bool>  isStpSent;
+	static bool          supportBreakNow;
 };
 
 #define SC_Derived(checkerName, supportB, ntkIsC)                                  \
@@ -99,12 +125,17 @@ SafetyChecker* getChecker(AigNtk* ntkToCheck, size_t outputIdx, bool _trace, siz
 	static_assert(is_convertible_v<Checker*, SafetyChecker*>);
 	if(!ntkToCheck->checkCombLoop(true))
 		return 0;
-	if(outputIdx >= ntkToCheck->getOutputNum())
+	if(outputIdx == SFC_ALL_OUTPUT)
+	{
+		if(ntkToCheck->getOutputNum() == 0)
+			{ cerr << "[Error] The network has no output!" << endl; return 0; }
+	}
+	else if(outputIdx >= ntkToCheck->getOutputNum())
 		{ cerr << "[Error] The output index (" << outputIdx
 		       << ") is out of range!" << endl; return 0; }
-	if(ntkToCheck->noLatchInCone(outputIdx))
+	else if(ntkToCheck->noLatchInCone(outputIdx))
 	{
-		cout << "No latch related to the property. Reduce to combinational checker!" << endl;
+		sfcOut << "No latch related to the property. Reduce to combinational checker!" << endl;
 		return (new CombChecker(ntkToCheck, outputIdx, _trace, timeout));
 	}
 	try { return (new Checker(ntkToCheck, outputIdx, _trace, timeout, forward<Param>(param)...)); }
@@ -4,19 +4,23 @@
 |: [Synopsis] Define and implement the commands to check safety property :|
 <------------------------------------------------------------------------*/
 
+#include <random>
 #include "cmdMgr.h"
 #include "sfcChecker.h"
 #include "bmcChecker.h"
 #include "pdrChecker.h"
 #include "pbcChecker.h"
+#include "ptfChecker.h"
 
 namespace _54ff
 {
 
-CmdClass(BmcCheck, CMD_TYPE_VERIFICATION, 4, "-TRace",   3,
-                                             "-Max",     2,
-                                             "-Assert",  2,
-                                             "-TImeout", 3);
+CmdClass(BmcCheck, CMD_TYPE_VERIFICATION, 6, "-TRace",     3,
+                                             "-Max",       2,
+                                             "-Assert",    2,
+                                             "-TImeout",   3,
+                                             "-OUTputs",   4,
+                                             "-GRoup",     3);
 CmdClass(IndCheck, CMD_TYPE_VERIFICATION, 5, "-TRace",   3,
                                              "-Max",     2,
                                              "-Need",    2,
@@ -27,43 +31,52 @@ CmdClass(ItpCheck, CMD_TYPE_VERIFICATION, 5, "-TRace",   3,
                                              "-All",     2,
                                              "-Last",    2,
                                              "-TImeout", 3);
-CmdClass(PdrCheck, CMD_TYPE_VERIFICATION, 37, "-TRace",     3,
-                                              "-Max",       2,
-                                              "-EVent",     3,
-                                              "-Backward",  2,
-                                              "-INTernal",  4,
-                                              "-ACtivity",  3,
-                                              "-Push",      2,
-                                              "-Decay",     2,
-                                              "-REVerse",   4,
-                                              "-Queue",     2,
-                                              "-EAger",     3,
-                                              "-STat",      3,
-                                              "-TImeout",   3,
-                                              "-NOPush",    4,
-                                              "-Verbose",   2,
-                                              "-RECycle",   4,
-                                              "-NOGen",     4,
-                                              "-APPROXGen", 8,
-                                              "-INFinite",  4,
-                                              "-NEEDCone",  6,
-                                              "-SElf",      3,
-                                              "-ASsert",    3,
-                                              "-CAlled",    3,
-                                              "-NEEDFrame", 6,
-                                              "-CHeck",     3,
-                                              "-LOCALInf",  7,
-                                              "-LOCALAll",  7,
-                                              "-LOCALMix",  7,
-                                              "-HALF",      5,
-                                              "-SATLimit",  5,
-                                              "-SHAREInf",  7,
-                                              "-OBLLimit",  5,
-                                              "-SHAREAll",  7,
-                                              "-LAzy",      3,
-                                              "-OBLAll",    5,
-                                              "-OBLDepth",  5,
-                                              "-LOCALGold", 7);
+CmdClass(PdrCheck, CMD_TYPE_VERIFICATION, 46, "-TRace",       3,
+                                              "-Max",         2,
+                                              "-EVent",       3,
+                                              "-Backward",    2,
+                                              "-INTernal",    4,
+                                              "-ACtivity",    3,
+                                              "-Push",        2,
+                                              "-Decay",       2,
+                                              "-REVerse",     4,
+                                              "-Queue",       2,
+                                              "-EAger",       3,
+                                              "-STat",        3,
+                                              "-TImeout",     3,
+                                              "-NOPush",      4,
+                                              "-Verbose",     2,
+                                              "-RECycle",     4,
+                                              "-NOGen",       4,
+                                              "-APPROXGen",   8,
+                                              "-INFinite",    4,
+                                              "-NEEDCone",    6,
+                                              "-SElf",        3,
+                                              "-ASsert",      3,
+                                              "-CAlled",      3,
+                                              "-NEEDFrame",   6,
+                                              "-CHeck",       3,
+                                              "-LOCALInf",    7,
+                                              "-LOCALAll",    7,
+                                              "-LOCALMix",    7,
+                                              "-HALF",        5,
+                                              "-SATLimit",    5,
+                                              "-SHAREInf",    7,
+                                              "-OBLLimit",    5,
+                                              "-SHAREAll",    7,
+                                              "-LAzy",        3,
+                                              "-OBLAll",      5,
+                                              "-OBLDepth",    5,
+                                              "-LOCALGold",   7,
+                                              "-THread",      3,
+                                              "-SPlit",       3,
+                                              "-COLLect",     5,
+                                              "-HEap",        3,
+                                              "-CTG",         4,
+                                              "-LIFt",        4,
+                                              "-FRAMESolver", 7,
+                                              "-SIMFilter",   5,
+                                              "-OUTputs",     4);
 CmdClass(PbcCheck, CMD_TYPE_VERIFICATION, 9, "-TRace",     3,
                                              "-Max",       2,
                                              "-Stat",      2,
@@ -73,6 +86,12 @@ CmdClass(PbcCheck, CMD_TYPE_VERIFICATION, 9, "-TRace",     3,
                                              "-Upto",      2,
                                              "-Block",     2,
                                              "-Increase",  2);
+CmdClass(PtfCheck, CMD_TYPE_VERIFICATION, 5, "-TRace",   3,
+                                             "-Max",     2,
+                                             "-Engine",  2,
+                                             "-TImeout", 3,
+                                             "-Verbose", 2);
+CmdClass(TestSubsume, CMD_TYPE_HIDDEN, 0);
 
 struct SfcRegistrar : public CmdRegistrar
 {
@@ -84,18 +103,22 @@ struct SfcRegistrar : public CmdRegistrar
 		setLine(); cmdMgr->regCmd<ItpCheckCmd>("CHEck SAfety ITp", 3, 2, 2);
 		setLine(); cmdMgr->regCmd<PdrCheckCmd>("CHEck SAfety PDr", 3, 2, 2);
 		setLine(); cmdMgr->regCmd<PbcCheckCmd>("CHEck SAfety PBc", 3, 2, 2);
+		setLine(); cmdMgr->regCmd<PtfCheckCmd>("CHEck SAfety PORtfolio", 3, 2, 3);
+		setLine(); cmdMgr->regCmd<TestSubsumeCmd>("TESt SUbsume", 3, 2);
 	}
 } static sfcRegistrar;
 
 /*========================================================================
-	CHEck SAfety Bmc <(unsigned outputIdx)> [-TRace]
+	CHEck SAfety Bmc <(unsigned outputIdx) | -OUTputs [-GRoup]> [-TRace]
 	                 [-TImeout (unsigned timeout)]
 	                 [-Max (unsigned maxDepth)] [-Assert]
 --------------------------------------------------------------------------
-	0: -TRace,   3
-	1: -Max,     2
-	2: -Assert,  2
-	3: -TImeout, 3
+	0: -TRace,     3
+	1: -Max,       2
+	2: -Assert,    2
+	3: -TImeout,   3
+	4: -OUTputs,   4
+	5: -GRoup,     3
 ========================================================================*/
 
 CmdExecStatus
@@ -105,13 +128,16 @@ BmcCheckCmd::exec(char* options)const
 	if(tokens.size() == 0)
 		return errorOption(CMD_OPT_MISSING);
 	size_t outputIdx;
-	if(!myStrToUInt(tokens[0], outputIdx))
+	if(optMatch<4>(tokens[0]))
+		outputIdx = SFC_ALL_OUTPUT;
+	else if(!myStrToUInt(tokens[0], outputIdx))
 		return errorOption(CMD_OPT_INVALID_UINT, tokens[0]);
 	size_t maxDepth = 100;
 	bool customMax = false;
 	size_t timeout = 0;
 	bool customTime = false;
 	BmcCheckType bct = BMC_ONLY_LAST;
+	bool groupQ = false;
 	bool trace = false;
 	for(size_t i = 1, n = tokens.size(); i < n; ++i)
 		if(optMatch<0>(tokens[i]))
@@ -146,9 +172,17 @@ BmcCheckCmd::exec(char* options)const
 				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
 			customTime = true;
 		}
+		else if(optMatch<5>(tokens[i]))
+		{
+			if(groupQ)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(outputIdx != SFC_ALL_OUTPUT)
+				return errorOption(CMD_OPT_ILLEGAL, tokens[i]);
+			groupQ = true;
+		}
 		else return errorOption(CMD_OPT_ILLEGAL, tokens[i]);
 	if(!checkNtk()) return CMD_EXEC_ERROR_INT;
-	SafetyChecker* checker = getChecker<BmcChecker>(aigNtk, outputIdx, trace, timeout, maxDepth, bct);
+	SafetyChecker* checker = getChecker<BmcChecker>(aigNtk, outputIdx, trace, timeout, maxDepth, bct, groupQ);
 	if(checker == 0) return CMD_EXEC_ERROR_INT;
 	checker->Check(); delete checker; return CMD_EXEC_DONE;
 }
@@ -156,7 +190,7 @@ BmcCheckCmd::exec(char* options)const
 const char*
 BmcCheckCmd::getUsageStr()const
 {
-	return "<(unsigned outputIdx)> [-Trace]\n"
+	return "<(unsigned outputIdx) | -OUTputs [-GRoup]> [-Trace]\n"
 	       "[-TImeout (unsigned timeout)]\n"
 	       "[-Max (unsigned maxDepth)] [-Assert]\n";
 }
@@ -342,63 +376,74 @@ ItpCheckCmd::getHelpStr()const
 }
 
 /*========================================================================
-	CHEck SAfety PDr <(unsigned outputIdx)> [-TRace]
+	CHEck SAfety PDr <(unsigned outputIdx) | -OUTputs> [-TRace]
 	                 [-TImeout (unsigned timeout)]
 	                 [-Max (unsigned maxFrame)]
 	                 [-SATLimit (unsigned satLimit)]
 	                 [-OBLLimit (unsigned oblLimit)]
-	                 [<-RECycle (unsigned recycleNum)> [-CAlled]]
-	                 [-EVent | -Backward | -INTernal]
+	                 [<-RECycle (unsigned recycleNum)> [-CAlled] [-COLLect]]
+	                 [-EVent | -Backward | -INTernal | -LIFt]
 	                 [-NEEDCone] [-NEEDFrame]
 	                 [<-ACtivity | -Decay> [-REVerse]] [-SElf]
-	                 [-Push | -NOPush] [-Queue]
-	                 [-APPROXGen | -NOGen]
-	                 [-EAger] [-INFinite] [-ASsert] [-LAzy]
+	                 [-Push | -NOPush] [-Queue | -HEap <"s" | "d" | "a">]
+	                 [-APPROXGen | -NOGen | -CTG (unsigned ctgNum ctgDepth)]
+	                 [-EAger] [-INFinite] [-ASsert] [-LAzy] [-FRAMESolver]
+	                 [-SIMFilter (unsigned blockNum)]
 	                 [-STat ("atsgprcx")] [-Verbose ("aogpbtcimfx")]
 	                 [<<-LOCALInf | -LOCALAll | -LOCALMix> (unsigned backtrackNum matchNum) |
 	                    -HALF                              (unsigned observeNum matchNum)   |
 	                    -LOCALGold                                                          |
 	                   <-OBLAll | -OBLDepth>               (unsigned oblThreshold)>
 	                  (unsigned satLimit) [-SHAREInf | -SHAREAll]]
-                     [-CHeck]
+                     [-CHeck] [-THread (unsigned threadNum)]
+                     [-SPlit (unsigned propThreadNum)]
 --------------------------------------------------------------------------
-	0:  -TRace,     3
-	1:  -Max,       2
-	2:  -EVent,     3
-	3:  -Backward,  2
-	4:  -INTernal,  4
-	5:  -ACtivity,  3
-	6:  -Push,      2
-	7:  -Decay,     2
-	8:  -REVerse,   4
-	9:  -Queue,     2
-	10: -EAger,     3
-	11: -STat,      3
-	12: -TImeout,   3
-	13: -NOPush,    4
-	14: -Verbose,   2
-	15: -RECycle,   4
-	16: -NOGen,     4
-	17: -APPROXGen, 8
-	18: -INFinite,  4
-	19: -NEEDCone,  6
-	20: -SElf,      3
-	21: -ASsert,    3
-	22: -CAlled,    3
-	23: -NEEDFrame, 6
-	24: -CHeck,     3
-	25: -LOCALInf,  7
-	26: -LOCALAll,  7
-	27: -LOCALMix,  7
-	28: -HALF,      5
-	29: -SATLimit,  5
-	30: -SHAREInf,  7
-	31: -OBLLimit,  5
-	32: -SHAREAll,  7
-	33: -LAzy,      3
-	34: -OBLAll,    5
-	35: -OBLDepth,  5
-	36: -LOCALGold, 7
+	0:  -TRace,       3
+	1:  -Max,         2
+	2:  -EVent,       3
+	3:  -Backward,    2
+	4:  -INTernal,    4
+	5:  -ACtivity,    3
+	6:  -Push,        2
+	7:  -Decay,       2
+	8:  -REVerse,     4
+	9:  -Queue,       2
+	10: -EAger,       3
+	11: -STat,        3
+	12: -TImeout,     3
+	13: -NOPush,      4
+	14: -Verbose,     2
+	15: -RECycle,     4
+	16: -NOGen,       4
+	17: -APPROXGen,   8
+	18: -INFinite,    4
+	19: -NEEDCone,    6
+	20: -SElf,        3
+	21: -ASsert,      3
+	22: -CAlled,      3
+	23: -NEEDFrame,   6
+	24: -CHeck,       3
+	25: -LOCALInf,    7
+	26: -LOCALAll,    7
+	27: -LOCALMix,    7
+	28: -HALF,        5
+	29: -SATLimit,    5
+	30: -SHAREInf,    7
+	31: -OBLLimit,    5
+	32: -SHAREAll,    7
+	33: -LAzy,        3
+	34: -OBLAll,      5
+	35: -OBLDepth,    5
+	36: -LOCALGold,   7
+	37: -THread,      3
+	38: -SPlit,       3
+	39: -COLLect,     5
+	40: -HEap,        3
+	41: -CTG,         4
+	42: -LIFt,        4
+	43: -FRAMESolver, 7
+	44: -SIMFilter,   5
+	45: -OUTputs,     4
 ========================================================================*/
 
 CmdExecStatus
@@ -408,7 +453,9 @@ PdrCheckCmd::exec(char* options)const
 	if(tokens.size() == 0)
 		return errorOption(CMD_OPT_MISSING);
 	size_t outputIdx;
-	if(!myStrToUInt(tokens[0], outputIdx))
+	if(optMatch<45>(tokens[0]))
+		outputIdx = SFC_ALL_OUTPUT;
+	else if(!myStrToUInt(tokens[0], outputIdx))
 		return errorOption(CMD_OPT_INVALID_UINT, tokens[0]);
 
 	bool trace = false;
@@ -432,9 +479,11 @@ PdrCheckCmd::exec(char* options)const
 	bool cSelf     = false;
 	bool assertF   = false;
 	bool recycleBQ = false;
+	bool recycleInc = false;
 	bool cInNeedF  = false;
 	bool lazyP     = false;
 	bool sortByBD  = false; //TODO, set option
+	bool perFrameS = false;
 
 	size_t stats     = 0;
 	size_t verbosity = 0;
@@ -445,6 +494,14 @@ PdrCheckCmd::exec(char* options)const
 	size_t oblL = 0;
 	bool customOblLimit = false;
 
+	size_t threadNum = 1;
+	bool customThread = false;
+	size_t propThreadNum = 1;
+	bool customPropThread = false;
+	size_t ctgNum   = 0;
+	size_t ctgDepth = 0;
+	size_t patBlockNum = 0;
+
 	PdrClsStimuType pcstt = PDR_CLS_STIMU_NONE;
 	PdrShareType    pcsht = PDR_SHARE_NONE;
 	size_t clsStimuNum1, clsStimuNum2, clsStimuNum3;
@@ -876,12 +933,97 @@ PdrCheckCmd::exec(char* options)const
 				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
 			pcstt = PDR_CLS_STIMU_LOCAL_GOLD;
 		}
+		else if(optMatch<37>(tokens[i]))
+		{
+			if(customThread)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(!myStrToUInt(tokens[i], threadNum))
+				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
+			if(threadNum == 0)
+				{ cerr << "[Error] threadNum cannot be 0!" << endl; return CMD_EXEC_ERROR_EXT; }
+			customThread = true;
+		}
+		else if(optMatch<38>(tokens[i]))
+		{
+			if(customPropThread)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(!myStrToUInt(tokens[i], propThreadNum))
+				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
+			if(propThreadNum == 0)
+				{ cerr << "[Error] propThreadNum cannot be 0!" << endl; return CMD_EXEC_ERROR_EXT; }
+			customPropThread = true;
+		}
+		else if(optMatch<39>(tokens[i]))
+		{
+			if(recycleInc)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(!customRecycle)
+				return errorOption(CMD_OPT_ILLEGAL, tokens[i]);
+			recycleInc = true;
+		}
+		else if(optMatch<40>(tokens[i]))
+		{
+			if(pdt != PDR_DEQ_STACK)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(strlen(tokens[i]) != 1)
+				return errorOption(CMD_OPT_ILLEGAL, tokens[i]);
+			switch(tokens[i][0])
+			{
+				case 's' : pdt = PDR_DEQ_SMALL;    break;
+				case 'd' : pdt = PDR_DEQ_DEPTH;    break;
+				case 'a' : pdt = PDR_DEQ_ACTIVITY; break;
+				default  : return errorOption(CMD_OPT_ILLEGAL, tokens[i]);
+			}
+		}
+		else if(optMatch<41>(tokens[i]))
+		{
+			if(pgt != PDR_GEN_NORMAL)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(!myStrToUInt(tokens[i], ctgNum))
+				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(!myStrToUInt(tokens[i], ctgDepth))
+				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
+			pgt = PDR_GEN_CTG;
+		}
+		else if(optMatch<42>(tokens[i]))
+		{
+			if(psit != PDR_SIM_FORWARD_NORMAL)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			psit = PDR_SIM_LIFT;
+		}
+		else if(optMatch<43>(tokens[i]))
+		{
+			if(perFrameS)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			perFrameS = true;
+		}
+		else if(optMatch<44>(tokens[i]))
+		{
+			if(patBlockNum != 0)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(!myStrToUInt(tokens[i], patBlockNum))
+				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
+			if(patBlockNum == 0)
+				{ cerr << "[Error] blockNum cannot be 0!" << endl; return CMD_EXEC_ERROR_EXT; }
+		}
 		else return errorOption(CMD_OPT_ILLEGAL, tokens[i]);
 	if(!checkNtk()) return CMD_EXEC_ERROR_INT;
 	SafetyChecker* checker = getChecker<PdrChecker>(aigNtk, outputIdx, trace, timeout, maxFrame, recycleNum, stats,
 	                                                psit, port, pobt, pdt, ppt, pgt,
-	                                                rInf, cInNeedC, cSelf, assertF, recycleBQ, cInNeedF, lazyP, sortByBD,
-	                                                satQL, oblL, verbosity, checkII,
+	                                                rInf, cInNeedC, cSelf, assertF, recycleBQ, recycleInc, cInNeedF, lazyP, sortByBD, perFrameS,
+	                                                satQL, oblL, verbosity, checkII, threadNum, propThreadNum, ctgNum, ctgDepth, patBlockNum,
 	                                                pcstt, pcsht, clsStimuNum1, clsStimuNum2, clsStimuNum3,
 	                                                postt, posht, oblStimuNum1, oblStimuNum2);
 	if(checker == 0) return CMD_EXEC_ERROR_INT;
@@ -891,25 +1033,27 @@ PdrCheckCmd::exec(char* options)const
 const char*
 PdrCheckCmd::getUsageStr()const
 {
-	return "<(unsigned outputIdx)> [-TRace]\n"
+	return "<(unsigned outputIdx) | -OUTputs> [-TRace]\n"
 	       "[-TImeout (unsigned timeout)]\n"
            "[-Max (unsigned maxFrame)]\n"
 	       "[-SATLimit (unsigned satLimit)]\n"
 	       "[-OBLLimit (unsigned oblLimit)]\n"
-	       "[<-RECycle (unsigned recycleNum)> [-CAlled]]\n"
-           "[-EVent | -Backward | -INTernal]\n"
+	       "[<-RECycle (unsigned recycleNum)> [-CAlled] [-COLLect]]\n"
+           "[-EVent | -Backward | -INTernal | -LIFt]\n"
 	       "[-NEEDCone] [-NEEDFrame]\n"
 	       "[<-ACtivity | -Decay> [-REVerse]] [-SElf]\n"
-	       "[-Push | -NOPush] [-Queue]\n"
-	       "[-APPROXGen | -NOGen]\n"
-	       "[-EAger] [-INFinite] [-ASsert] [-LAzy]\n"
+	       "[-Push | -NOPush] [-Queue | -HEap <\"s\" | \"d\" | \"a\">]\n"
+	       "[-APPROXGen | -NOGen | -CTG (unsigned ctgNum ctgDepth)]\n"
+	       "[-EAger] [-INFinite] [-ASsert] [-LAzy] [-FRAMESolver]\n"
+	       "[-SIMFilter (unsigned blockNum)]\n"
 	       "[-STat (\"atsgprcx\")] [-Verbose (\"aogpbtcimfx\")]\n"
 	       "[<<-LOCALInf | -LOCALAll | -LOCALMix> (unsigned backtrackNum matchNum) |\n"
 	       "   -HALF                              (unsigned observeNum matchNum)   |\n"
 	       "   -LOCALGold                                                          |\n"
 	       "  <-OBLAll | -OBLDepth>               (unsigned oblThreshold)>\n"
 	       " (unsigned satLimit) [-SHAREInf | -SHAREAll]]\n"
-	       "[-CHeck]\n";
+	       "[-CHeck] [-THread (unsigned threadNum)]\n"
+	       "[-SPlit (unsigned propThreadNum)]\n";
 }
 
 const char*
@@ -1099,4 +1243,221 @@ PbcCheckCmd::getHelpStr()const
 	return "Check safety property of AIG network using property directed bounded model checking\n";
 }
 
+/*========================================================================
+	CHEck SAfety PORtfolio <(unsigned outputIdx)> [-TRace]
+	                       [-TImeout (unsigned timeout)]
+	                       [-Max (unsigned maxDepth)]
+	                       [-Engine ("apcbki")] [-Verbose]
+--------------------------------------------------------------------------
+	0: -TRace,   3
+	1: -Max,     2
+	2: -Engine,  2
+	3: -TImeout, 3
+	4: -Verbose, 2
+========================================================================*/
+
+CmdExecStatus
+PtfCheckCmd::exec(char* options)const
+{
+	PureStrList tokens = breakToTokens(options);
+	if(tokens.size() == 0)
+		return errorOption(CMD_OPT_MISSING);
+	size_t outputIdx;
+	if(!myStrToUInt(tokens[0], outputIdx))
+		return errorOption(CMD_OPT_INVALID_UINT, tokens[0]);
+
+	bool trace = false;
+	size_t maxDepth = 100;
+	bool customMax = false;
+
+	size_t timeout = 0;
+	bool customTime = false;
+
+	bool customEngine = false;
+	Array<bool> engine(PTF_ENGINE_TOTAL);
+	for(unsigned i = 0; i < PTF_ENGINE_TOTAL; ++i)
+		engine[i] = false;
+	bool verbose = false;
+
+	for(size_t i = 1, n = tokens.size(); i < n; ++i)
+		if(optMatch<0>(tokens[i]))
+		{
+			if(trace)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			trace = true;
+		}
+		else if(optMatch<1>(tokens[i]))
+		{
+			if(customMax)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(!myStrToUInt(tokens[i], maxDepth))
+				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
+			customMax = true;
+		}
+		else if(optMatch<2>(tokens[i]))
+		{
+			if(customEngine)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			char buffer[2] = { 0, 0 };
+			for(const char* tmp = tokens[i]; *tmp != 0; ++tmp)
+			{
+				PtfEngineType pet;
+				switch(*tmp)
+				{
+					case 'a' : pet = PTF_ENGINE_ALL;   break;
+					case 'p' : pet = PTF_ENGINE_PDR;   break;
+					case 'c' : pet = PTF_ENGINE_PBC;   break;
+					case 'b' : pet = PTF_ENGINE_BMC;   break;
+					case 'k' : pet = PTF_ENGINE_IND;   break;
+					case 'i' : pet = PTF_ENGINE_ITP;   break;
+					default  : pet = PTF_ENGINE_ERROR; break;
+				}
+				switch(pet)
+				{
+					case PTF_ENGINE_ALL:
+						for(unsigned i = 0; i < PTF_ENGINE_TOTAL; ++i)
+							if(engine[i])
+								{ buffer[0] = *tmp; return errorOption(CMD_OPT_EXTRA, buffer); }
+							else engine[i] = true;
+						break;
+
+					case PTF_ENGINE_ERROR:
+						buffer[0] = *tmp;
+						return errorOption(CMD_OPT_ILLEGAL, buffer);
+
+					default:
+						if(engine[pet])
+							{ buffer[0] = *tmp; return errorOption(CMD_OPT_EXTRA, buffer); }
+						else engine[pet] = true;
+				}
+			}
+			customEngine = true;
+		}
+		else if(optMatch<3>(tokens[i]))
+		{
+			if(customTime)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			if(++i == n)
+				return errorOption(CMD_OPT_MISSING);
+			if(!myStrToUInt(tokens[i], timeout))
+				return errorOption(CMD_OPT_INVALID_UINT, tokens[i]);
+			customTime = true;
+		}
+		else if(optMatch<4>(tokens[i]))
+		{
+			if(verbose)
+				return errorOption(CMD_OPT_EXTRA, tokens[i]);
+			verbose = true;
+		}
+		else return errorOption(CMD_OPT_ILLEGAL, tokens[i]);
+	if(!customEngine)
+		for(unsigned i = 0; i < PTF_ENGINE_TOTAL; ++i)
+			engine[i] = true;
+	if(!checkNtk()) return CMD_EXEC_ERROR_INT;
+	SafetyChecker* checker = getChecker<PtfChecker>(aigNtk, outputIdx, trace, timeout, maxDepth, engine, verbose);
+	if(checker == 0) return CMD_EXEC_ERROR_INT;
+	checker->Check(); delete checker; return CMD_EXEC_DONE;
+}
+
+const char*
+PtfCheckCmd::getUsageStr()const
+{
+	return "<(unsigned outputIdx)> [-TRace]\n"
+	       "[-TImeout (unsigned timeout)]\n"
+	       "[-Max (unsigned maxDepth)]\n"
+	       "[-Engine (\"apcbki\")] [-Verbose]\n";
+}
+
+const char*
+PtfCheckCmd::getHelpStr()const
+{
+	return "Check safety property of AIG network by racing several engines in parallel\n";
+}
+
+/*========================================================================
+	TESt SUbsume
+--------------------------------------------------------------------------
+	Compare the scalar and the vectorized subsumption kernels of PdrCube
+	on random sorted cubes, both the results and the runtime
+========================================================================*/
+
+CmdExecStatus
+TestSubsumeCmd::exec(char* options)const
+{
+	PureStrList tokens = breakToTokens(options);
+	if(!tokens.empty())
+		return errorOption(CMD_OPT_EXTRA, tokens[0]);
+
+	constexpr size_t pairNum  = 1000;
+	constexpr size_t checkNum = 40000000;
+	const unsigned sizeList[] = { 5, 10, 20, 50, 100, 200 };
+	mt19937 gen(54);
+	streamsize ss = cout.precision();
+	cout << "Kernel : " << PdrCube::getSubsumeKernelStr() << endl
+	     << "  Size  Scalar (s)  Vector (s)  Speedup" << endl
+	     << fixed;
+	for(unsigned s: sizeList)
+	{
+		// The smaller cube takes half of the larger one, and one literal of it is inverted half of the time
+		vector<PdrCube> smallCube, largeCube;
+		vector<AigGateID> idList(4 * s);
+		for(AigGateID i = 0; i < 4 * s; ++i)
+			idList[i] = i + 1;
+		for(size_t k = 0; k < pairNum; ++k)
+		{
+			shuffle(idList.begin(), idList.end(), gen);
+			vector<AigGateLit> litList(s);
+			for(unsigned i = 0; i < s; ++i)
+				litList[i] = (idList[i] << 1) | (gen() & 1);
+			largeCube.emplace_back(litList, true);
+			litList.resize(s / 2);
+			if(gen() & 1)
+				litList[0] ^= 1;
+			smallCube.emplace_back(litList, true);
+		}
+		const size_t roundNum = checkNum / (pairNum * s) + 1;
+		auto runKernel = [&](bool vec, vector<AigGateLit>& result) -> double
+		{
+			result.assign(pairNum * 2, 0);
+			const clock_t start = clock();
+			for(size_t r = 0; r < roundNum; ++r)
+				for(size_t k = 0; k < pairNum; ++k)
+				{
+					const PdrCube& a = smallCube[k];
+					const PdrCube& b = largeCube[k];
+					result[2*k]   += vec ? a.subsumeComplexV(b) : a.subsumeComplexN(b);
+					result[2*k+1] += vec ? a.selfSubsumeComplexV(b) : a.selfSubsumeComplex(b);
+				}
+			return double(clock() - start) / CLOCKS_PER_SEC;
+		};
+		vector<AigGateLit> resultN, resultV;
+		const double timeN = runKernel(false, resultN);
+		const double timeV = runKernel(true,  resultV);
+		if(resultN != resultV)
+			{ cerr << "[Error] The kernels disagree on cubes of size " << s << "!" << endl;
+			  cout << setprecision(ss); cout.unsetf(ios_base::floatfield); return CMD_EXEC_ERROR_INT; }
+		cout << setw(6) << s << setprecision(3) << setw(12) << timeN << setw(12) << timeV
+		     << setprecision(2) << setw(8) << (timeV == 0 ? 0.0 : timeN / timeV) << "x" << endl;
+	}
+	cout << setprecision(ss);
+	cout.unsetf(ios_base::floatfield);
+	return CMD_EXEC_DONE;
+}
+
+const char*
+TestSubsumeCmd::getUsageStr()const
+{
+	return "\n";
+}
+
+const char*
+TestSubsumeCmd::getHelpStr()const
+{
+	return "Compare the scalar and the vectorized subsumption kernels of cubes\n";
+}
+
 }